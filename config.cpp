@@ -48,6 +48,11 @@ class CfgMods
                 value = "";
                 files[] = {"MutantSpawnSystem/scripts/4_World"};
             };
+            class missionScriptModule
+            {
+                value = "";
+                files[] = {"MutantSpawnSystem/scripts/5_Mission"};
+            };
         };
     };
 };
\ No newline at end of file
@@ -9,10 +9,12 @@ class TierConfig : Managed
 {
     string name;
     ref array<string> classnames;
+    ref array<float> weights;  // Optional, one per classname
     
     void TierConfig()
     {
         classnames = new array<string>;
+        weights = new array<float>;
     }
 }
 
@@ -31,12 +33,14 @@ class SpawnPointConfig : Managed
     string position;
     float radius;
     ref array<int> tierIds;
+    ref array<float> tierWeights;  // Optional, one per tier id
     int entities;
     bool useFixedHeight;
     
     void SpawnPointConfig()
     {
         tierIds = new array<int>;
+        tierWeights = new array<float>;
         radius = 2.0;
         entities = 1;
         useFixedHeight = false;
@@ -53,6 +57,9 @@ class ZoneConfig : Managed
     bool despawnOnExit;
     float despawnDistance;
     float respawnCooldown;
+    float exitRadius;     // Players count as inside until beyond this, 0 = triggerRadius
+    float armingDelay;    // Seconds a player must stay inside before the zone spawns
+    float despawnGrace;   // Seconds the zone must stay empty before it despawns
     ref array<ref SpawnPointConfig> spawnPoints;
     
     void ZoneConfig()
@@ -64,6 +71,9 @@ class ZoneConfig : Managed
         despawnDistance = 400.0;
         respawnCooldown = 300.0;
         triggerRadius = 300.0;
+        exitRadius = 0;
+        armingDelay = 0;
+        despawnGrace = 0;
     }
 }
 
@@ -72,16 +82,54 @@ class GlobalSettingsConfig : Managed
     bool systemEnabled;
     float checkInterval;
     int maxEntitiesPerZone;
+    int maxTotalEntities;
     int entityLifetime;
     float minSpawnDistanceFromPlayer;
+    int spawnsPerTick;
+    float spawnBudgetMs;
+    int despawnsPerTick;
+    float despawnBudgetMs;
+    bool entityPoolEnabled;
+    int entityPoolSize;
+    bool adaptiveCheckInterval;
+    float minCheckInterval;
+    float maxCheckInterval;
+    float checkBudgetMs;
+    int stateSnapshotInterval;
+    int metricsFlushInterval;
+    int logLevel;
+    bool virtualPopulationEnabled;
+    bool timeSlicedChecks;
+    int zonesPerTick;
+    float zoneBudgetMs;
+    float virtualHealthRegenPerHour;
     
     void GlobalSettingsConfig()
     {
         systemEnabled = true;
         checkInterval = 5.0;  // Faster checks but optimized
         maxEntitiesPerZone = 20;
+        maxTotalEntities = 300;  // Server-wide cap on spawned creatures (0 = no limit)
         entityLifetime = 1800;
         minSpawnDistanceFromPlayer = 30.0;
+        spawnsPerTick = 4;     // Entities created per spawn queue tick (0 = no limit)
+        spawnBudgetMs = 2.0;   // Script time per spawn queue tick (0 = no limit)
+        despawnsPerTick = 20;  // Entities deleted per despawn queue tick (0 = no limit)
+        despawnBudgetMs = 1.0; // Script time per despawn queue tick (0 = no limit)
+        entityPoolEnabled = false;
+        entityPoolSize = 100;
+        adaptiveCheckInterval = false;
+        minCheckInterval = 1.0;
+        maxCheckInterval = 30.0;
+        checkBudgetMs = 5.0;   // Checks slower than this lengthen the adaptive interval
+        stateSnapshotInterval = 300;  // Seconds between zone state snapshots (0 = only on shutdown)
+        metricsFlushInterval = 0;     // Seconds between phase metric flushes (0 = disabled)
+        logLevel = 2;                 // 0 = errors, 1 = warnings, 2 = info, 3 = debug
+        virtualPopulationEnabled = false;
+        timeSlicedChecks = false;
+        zonesPerTick = 25;     // Zones evaluated per 50 ms slice when time-sliced (0 = no limit)
+        zoneBudgetMs = 1.0;    // Script time per slice when time-sliced (0 = no limit)
+        virtualHealthRegenPerHour = 0.25;  // Fraction of max health regained per hour while virtual
     }
 }
 
@@ -98,14 +146,105 @@ class ZonesContainer : Managed
 }
 
 // Runtime classes
+// Walker/Vose alias table: O(n) to build, O(1) to draw a weighted index
+class SimpleAliasTable : Managed
+{
+    ref array<float> m_Probability;
+    ref array<int> m_Alias;
+    
+    void SimpleAliasTable()
+    {
+        m_Probability = new array<float>;
+        m_Alias = new array<int>;
+    }
+    
+    int Count()
+    {
+        return m_Alias.Count();
+    }
+    
+    // Builds a table over count entries. Weights are used if there is one per entry and they
+    // sum to more than zero, otherwise every entry is equally likely.
+    void Build(int count, array<float> weights)
+    {
+        m_Probability.Clear();
+        m_Alias.Clear();
+        
+        float total = 0;
+        bool weighted = (weights && weights.Count() == count);
+        if (weighted)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                total += Math.Max(weights.Get(i), 0);
+            }
+            weighted = (total > 0);
+        }
+        
+        array<float> scaled = new array<float>;
+        array<int> small = new array<int>;
+        array<int> large = new array<int>;
+        
+        for (int j = 0; j < count; j++)
+        {
+            float p = 1.0;
+            if (weighted)
+                p = Math.Max(weights.Get(j), 0) * count / total;
+            
+            scaled.Insert(p);
+            m_Probability.Insert(1.0);
+            m_Alias.Insert(j);
+            
+            if (p < 1.0)
+                small.Insert(j);
+            else
+                large.Insert(j);
+        }
+        
+        while (small.Count() > 0 && large.Count() > 0)
+        {
+            int less = small.Get(small.Count() - 1);
+            small.Remove(small.Count() - 1);
+            int more = large.Get(large.Count() - 1);
+            
+            m_Probability.Set(less, scaled.Get(less));
+            m_Alias.Set(less, more);
+            
+            float remaining = scaled.Get(more) + scaled.Get(less) - 1.0;
+            scaled.Set(more, remaining);
+            
+            if (remaining < 1.0)
+            {
+                large.Remove(large.Count() - 1);
+                small.Insert(more);
+            }
+        }
+        
+        // Whatever is left over is 1.0 up to rounding and keeps its default entry
+    }
+    
+    int Sample()
+    {
+        int column = Math.RandomInt(0, m_Alias.Count());
+        if (Math.RandomFloat01() < m_Probability.Get(column))
+            return column;
+        
+        return m_Alias.Get(column);
+    }
+}
+
 class SimpleTier : Managed
 {
     string name;
     ref array<string> classnames;
+    ref array<float> weights;
+    ref SimpleAliasTable classTable;  // Built from weights at load time
     
     void SimpleTier()
     {
         classnames = new array<string>;
+        weights = new array<float>;
+        classTable = new SimpleAliasTable();
     }
 }
 
@@ -114,20 +253,71 @@ class SimpleSpawnPoint : Managed
     vector position;
     float radius;
     ref array<int> tierIds;
+    ref array<float> tierWeights;
     int entities;
     bool useFixedHeight;
-    ref array<EntityAI> spawnedEntities;
+    ref array<ref SimpleSpawnedEntity> spawnedEntities;
+    
+    // Resolved at load time so spawning needs no map lookups
+    ref array<SimpleTier> tiers;
+    ref SimpleAliasTable tierTable;
+    
+    // Pre-validated spawn positions, built on the first spawn at this point
+    bool candidatesBuilt;
+    ref array<vector> candidates;
+    ref array<bool> candidateTaken;  // Held by a live entity of this point
+    
+    // Survivors of the last wave while the zone is virtual
+    ref array<ref SimpleVirtualCreature> virtualCreatures;
     
     void SimpleSpawnPoint()
     {
         tierIds = new array<int>;
-        spawnedEntities = new array<EntityAI>;
+        tierWeights = new array<float>;
+        tiers = new array<SimpleTier>;
+        tierTable = new SimpleAliasTable();
+        candidatesBuilt = false;
+        candidates = new array<vector>;
+        candidateTaken = new array<bool>;
+        virtualCreatures = new array<ref SimpleVirtualCreature>;
+        spawnedEntities = new array<ref SimpleSpawnedEntity>;
         radius = 2.0;
         entities = 1;
         useFixedHeight = false;
     }
 }
 
+// A creature of a zone nobody is near, kept as data instead of an entity
+class SimpleVirtualCreature : Managed
+{
+    string classname;
+    float health;  // Fraction of max health
+    vector position;
+}
+
+// Bookkeeping record for one spawned creature
+class SimpleSpawnedEntity : Managed
+{
+    EntityAI entity;
+    int entityId;
+    SimpleZone zone;
+    SimpleSpawnPoint point;
+    int candidate;  // Index into point.candidates held by this entity, -1 if none
+    
+    // Lifetime timer wheel state
+    int timerRounds;
+    bool timerActive;
+    int timerSlot;  // Wheel slot holding this record's entry, -1 if none
+    
+    void SimpleSpawnedEntity()
+    {
+        candidate = -1;
+        timerRounds = 0;
+        timerActive = false;
+        timerSlot = -1;
+    }
+}
+
 class SimpleZone : Managed
 {
     string name;
@@ -138,742 +328,3945 @@ class SimpleZone : Managed
     bool despawnOnExit;
     float despawnDistance;
     float respawnCooldown;
+    float exitRadius;  // Resolved, never below triggerRadius
+    float armingDelay;
+    float despawnGrace;
     ref array<ref SimpleSpawnPoint> spawnPoints;
     
+    // Enter/exit hysteresis
+    float armedSince;  // Manager time players entered, -1 = not arming
+    float emptySince;  // Manager time the zone became empty with creatures left, -1 = not pending
+    
     // Optimization fields
-    float cooldownTime;
+    float cooldownExpiry;  // Manager time when the cooldown ends, 0 = not cooling down
     bool hasSpawned;
     bool hasRolledChance;
-    ref array<Man> playersInside;
+    ref array<SimplePlayerState> playersInside;
+    
+    // Spawn queue state
+    int spawnWave;       // Bumped to invalidate queued jobs
+    int pendingSpawns;
+    int waveSpawned;
+    int liveEntities;    // Tracked entities across all spawn points
+    int queuedDespawns;  // Untracked entities still waiting in the despawn queue
+    
+    // Virtual population
+    int virtualCount;    // Virtual creatures across all spawn points
+    float virtualSince;  // Manager time the zone was virtualized
+    
+    // Membership tracking
+    ref array<SimplePlayerState> nearbyPlayers;  // Players within reach, maintained incrementally
+    int lastCheckEpoch;
+    
+    int id;  // Dense index into the manager's zone field arrays, -1 while not registered
+    
+    // Spatial index bookkeeping
+    bool isIndexed;
+    float indexRadius;
+    ref array<int> indexCells;  // Cells in the index, or precomputed ones from the cache before insertion
     
     void SimpleZone()
     {
         spawnPoints = new array<ref SimpleSpawnPoint>;
-        playersInside = new array<Man>;
+        playersInside = new array<SimplePlayerState>;
+        nearbyPlayers = new array<SimplePlayerState>;
+        lastCheckEpoch = 0;
+        id = -1;
+        isIndexed = false;
+        indexCells = new array<int>;
         enabled = true;
         spawnChance = 1.0;
         despawnOnExit = true;
         respawnCooldown = 300.0;
-        cooldownTime = 0;
+        exitRadius = 0;
+        armingDelay = 0;
+        despawnGrace = 0;
+        armedSince = -1;
+        emptySince = -1;
+        cooldownExpiry = 0;
         hasSpawned = false;
         hasRolledChance = false;
+        spawnWave = 0;
+        pendingSpawns = 0;
+        waveSpawned = 0;
+        liveEntities = 0;
+        virtualCount = 0;
+        virtualSince = 0;
     }
 }
 
-// ============= PART 2: OPTIMIZED SPAWN MANAGER =============
+class SimplePlayerState : Managed
+{
+    int playerId;
+    vector position;      // Position at the latest check
+    vector lastPosition;  // Position at the last zone refresh
+    int lastCellKey;
+    int lastSeenEpoch;
+    bool needsRefresh;
+    ref array<SimpleZone> zones;  // Zones whose reach contains this player
+    
+    // Position at the previous check, for speed estimates
+    vector samplePosition;
+    float sampleTime;
+    bool hasSample;
+    
+    void SimplePlayerState()
+    {
+        zones = new array<SimpleZone>;
+        lastSeenEpoch = 0;
+        needsRefresh = true;
+        hasSample = false;
+    }
+}
 
-class SimpleSpawnManager : Managed
+class SimpleHeapItem : Managed
 {
-    bool m_SystemEnabled;
-    float m_CheckTimer;
-    float m_CheckInterval;
-    float m_MinSpawnDistanceFromPlayer;
+    float priority;
+}
+
+class SimpleSpawnJob : SimpleHeapItem
+{
+    SimpleZone zone;
+    SimpleSpawnPoint point;
+    int wave;
+    ref SimpleVirtualCreature creature;  // Set when the job materializes a virtual creature
+    // priority: squared distance to the closest player
+}
+
+class SimpleDespawnJob : SimpleHeapItem
+{
+    EntityAI entity;
+    SimpleZone zone;
+    // priority: negated squared distance to the closest player, so the farthest pops first
+}
+
+class SimpleCooldownEntry : SimpleHeapItem
+{
+    SimpleZone zone;
+    // priority: manager time at which the cooldown ends
+}
+
+// Binary min-heap ordered by item priority
+class SimpleMinHeap : Managed
+{
+    ref array<ref SimpleHeapItem> m_Heap;
     
-    ref map<int, ref SimpleTier> m_Tiers;
-    ref map<string, ref SimpleZone> m_ZonesMap;
-    ref GlobalSettingsConfig m_GlobalSettings;
+    void SimpleMinHeap()
+    {
+        m_Heap = new array<ref SimpleHeapItem>;
+    }
     
-    // Spatial optimization
-    ref map<int, ref array<ref SimpleZone>> m_ZoneGrid;  // Grid-based zone lookup
-    static const int GRID_SIZE = 1000;  // 1km grid cells
+    int Count()
+    {
+        return m_Heap.Count();
+    }
     
-    void SimpleSpawnManager()
+    void Clear()
     {
-        m_SystemEnabled = true;
-        m_CheckTimer = 0.0;
-        m_CheckInterval = 5.0;  // Check more often but smarter
-        m_MinSpawnDistanceFromPlayer = 30.0;
-        
-        m_Tiers = new map<int, ref SimpleTier>;
-        m_ZonesMap = new map<string, ref SimpleZone>;
-        m_ZoneGrid = new map<int, ref array<ref SimpleZone>>;
-        m_GlobalSettings = new GlobalSettingsConfig;
-        
-        Print("[SpawnManager] === OPTIMIZED SPAWN SYSTEM v2.0 INITIALIZED ===");
+        m_Heap.Clear();
+    }
+    
+    SimpleHeapItem Peek()
+    {
+        if (m_Heap.Count() == 0)
+            return null;
         
-        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(CreateDefaultConfigs, 3000, false);
-        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(LoadAllConfigs, 8000, false);
-        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(CleanupDeadEntities, 60000, true);
+        return m_Heap.Get(0);
     }
     
-    void CreateDefaultConfigs()
+    void Push(SimpleHeapItem item)
     {
-        string configDir = "$profile:MutantSpawnSystem";
+        m_Heap.Insert(item);
         
-        if (!FileExist(configDir))
+        int i = m_Heap.Count() - 1;
+        while (i > 0)
         {
-            MakeDirectory(configDir);
-            Print("[SpawnManager] Created config directory");
+            int parent = (i - 1) / 2;
+            if (m_Heap.Get(parent).priority <= item.priority)
+                break;
+            
+            m_Heap.Set(i, m_Heap.Get(parent));
+            i = parent;
         }
+        m_Heap.Set(i, item);
+    }
+    
+    SimpleHeapItem Pop()
+    {
+        if (m_Heap.Count() == 0)
+            return null;
         
-        string tiersPath = "$profile:MutantSpawnSystem/Tiers.json";
-        if (!FileExist(tiersPath))
+        ref SimpleHeapItem top = m_Heap.Get(0);
+        ref SimpleHeapItem last = m_Heap.Get(m_Heap.Count() - 1);
+        m_Heap.Remove(m_Heap.Count() - 1);
+        
+        int count = m_Heap.Count();
+        if (count > 0)
         {
-            CreateDefaultTiers(tiersPath);
+            int i = 0;
+            while (true)
+            {
+                int child = (i * 2) + 1;
+                if (child >= count)
+                    break;
+                
+                if (child + 1 < count && m_Heap.Get(child + 1).priority < m_Heap.Get(child).priority)
+                    child++;
+                
+                if (last.priority <= m_Heap.Get(child).priority)
+                    break;
+                
+                m_Heap.Set(i, m_Heap.Get(child));
+                i = child;
+            }
+            m_Heap.Set(i, last);
         }
         
-        string zonesPath = "$profile:MutantSpawnSystem/Zones.json";
-        if (!FileExist(zonesPath))
+        return top;
+    }
+}
+
+// Hashed timer wheel for entity lifetimes. Each slot covers m_SlotSeconds; timers further away
+// than one revolution wait out the extra rounds in their slot. Scheduling a fresh record and
+// cancelling are O(1), and each advance only touches the slot under the cursor.
+class SimpleTimerWheel : Managed
+{
+    ref array<ref array<ref SimpleSpawnedEntity>> m_Slots;
+    int m_SlotCount;
+    float m_SlotSeconds;
+    int m_Cursor;
+    float m_Elapsed;
+    int m_Pending;
+    
+    void SimpleTimerWheel(int slotCount = 256, float slotSeconds = 1.0)
+    {
+        m_Slots = new array<ref array<ref SimpleSpawnedEntity>>;
+        m_SlotCount = slotCount;
+        m_SlotSeconds = slotSeconds;
+        m_Cursor = 0;
+        m_Elapsed = 0;
+        m_Pending = 0;
+        
+        for (int i = 0; i < m_SlotCount; i++)
         {
-            CreateDefaultZonesWithSpawnPoints(zonesPath);
+            m_Slots.Insert(new array<ref SimpleSpawnedEntity>);
         }
     }
     
-    void CreateDefaultTiers(string filePath)
+    int GetPendingCount()
     {
-        ref TiersContainer container = new TiersContainer();
-        
-        ref TierConfig tier1 = new TierConfig();
-        tier1.name = "Basic Zombies";
-        tier1.classnames.Insert("ZmbM_HunterOld_Autumn");
-        tier1.classnames.Insert("ZmbM_HunterOld_Spring");
-        tier1.classnames.Insert("ZmbF_SurvivorNormal_Blue");
-        tier1.classnames.Insert("ZmbF_SurvivorNormal_Red");
-        tier1.classnames.Insert("ZmbM_FarmerFat_Beige");
-        tier1.classnames.Insert("ZmbM_CitizenASkinny");
-        tier1.classnames.Insert("ZmbM_CitizenBFat");
-        container.tiers.Set(1, tier1);
+        return m_Pending;
+    }
+    
+    // A record has at most one entry; rescheduling moves it out of its old slot
+    void Schedule(SimpleSpawnedEntity record, float delay)
+    {
+        Cancel(record);
         
-        ref TierConfig tier2 = new TierConfig();
-        tier2.name = "Military Zombies";
-        tier2.classnames.Insert("ZmbM_SoldierNormal");
-        tier2.classnames.Insert("ZmbM_PatrolNormal_PautRev");
-        tier2.classnames.Insert("ZmbM_PatrolNormal_Autumn");
-        tier2.classnames.Insert("ZmbM_usSoldier_normal_Woodland");
-        container.tiers.Set(2, tier2);
+        int ticks = Math.Ceil(delay / m_SlotSeconds);
+        if (ticks < 1)
+            ticks = 1;
         
-        ref TierConfig tier3 = new TierConfig();
-        tier3.name = "Wildlife Predators";
-        tier3.classnames.Insert("Animal_UrsusArctos");
-        tier3.classnames.Insert("Animal_CanisLupus_Grey");
-        tier3.classnames.Insert("Animal_CanisLupus_White");
-        container.tiers.Set(3, tier3);
+        int target = (m_Cursor + ticks) % m_SlotCount;
+        if (record.timerSlot != target)
+        {
+            if (record.timerSlot >= 0)
+                m_Slots.Get(record.timerSlot).RemoveItem(record);
+            
+            m_Slots.Get(target).Insert(record);
+            record.timerSlot = target;
+        }
         
-        JsonFileLoader<TiersContainer>.JsonSaveFile(filePath, container);
-        Print("[SpawnManager] Created default Tiers.json");
+        record.timerRounds = (ticks - 1) / m_SlotCount;
+        record.timerActive = true;
+        m_Pending++;
     }
     
-    void CreateDefaultZonesWithSpawnPoints(string filePath)
+    // Cancelled records stay in their slot until the cursor passes and drops them
+    void Cancel(SimpleSpawnedEntity record)
     {
-        ref ZonesContainer container = new ZonesContainer();
+        if (!record.timerActive)
+            return;
         
-        container.globalSettings.systemEnabled = true;
-        container.globalSettings.checkInterval = 5.0;
-        container.globalSettings.maxEntitiesPerZone = 20;
-        container.globalSettings.entityLifetime = 600;
-        container.globalSettings.minSpawnDistanceFromPlayer = 30.0;
+        record.timerActive = false;
+        m_Pending--;
+    }
+    
+    void Advance(float timeslice, array<ref SimpleSpawnedEntity> expired)
+    {
+        m_Elapsed += timeslice;
         
-        // Zone 1: Urban Building Example
-        ref ZoneConfig zone1 = new ZoneConfig();
-        zone1.name = "Test_Zone_Cherno_Building";
-        zone1.enabled = true;
-        zone1.position = "6560 15 2630";
-        zone1.triggerRadius = 100;
-        zone1.spawnChance = 0.75;
-        zone1.despawnOnExit = true;
-        zone1.despawnDistance = 150;
-        zone1.respawnCooldown = 300;
+        while (m_Elapsed >= m_SlotSeconds)
+        {
+            m_Elapsed -= m_SlotSeconds;
+            m_Cursor = (m_Cursor + 1) % m_SlotCount;
+            
+            ref array<ref SimpleSpawnedEntity> slot = m_Slots.Get(m_Cursor);
+            for (int i = slot.Count() - 1; i >= 0; i--)
+            {
+                SimpleSpawnedEntity record = slot.Get(i);
+                
+                if (record.timerActive && record.timerRounds > 0)
+                {
+                    record.timerRounds--;
+                    continue;
+                }
+                
+                if (record.timerActive)
+                {
+                    record.timerActive = false;
+                    m_Pending--;
+                    expired.Insert(record);
+                }
+                record.timerSlot = -1;
+                slot.Remove(i);
+            }
+        }
+    }
+}
+
+// Parks despawned creatures out of sight instead of deleting them, so the next activation can
+// reuse them without paying for object creation and network replication again
+class SimpleEntityPool : Managed
+{
+    ref map<string, ref array<EntityAI>> m_Parked;
+    vector m_HoldingPosition;
+    int m_Capacity;
+    int m_ParkedCount;
+    int m_Hits;
+    int m_Misses;
+    
+    void SimpleEntityPool()
+    {
+        m_Parked = new map<string, ref array<EntityAI>>;
+        m_HoldingPosition = Vector(0, -500, 0);
+        m_Capacity = 0;
+        m_ParkedCount = 0;
+        m_Hits = 0;
+        m_Misses = 0;
+    }
+    
+    bool IsEnabled()
+    {
+        return m_Capacity > 0;
+    }
+    
+    void SetCapacity(int capacity)
+    {
+        m_Capacity = capacity;
         
-        ref SpawnPointConfig sp1 = new SpawnPointConfig();
-        sp1.position = "6555 15 2625";
-        sp1.radius = 1.5;
-        sp1.tierIds.Insert(1);
-        sp1.entities = 2;
-        sp1.useFixedHeight = false;
-        zone1.spawnPoints.Insert(sp1);
+        if (m_ParkedCount > m_Capacity)
+        {
+            Trim(m_ParkedCount - m_Capacity);
+        }
+    }
+    
+    // Deletes count parked entities, taking them from the fullest classname each time
+    void Trim(int count)
+    {
+        while (count > 0 && m_ParkedCount > 0)
+        {
+            ref array<EntityAI> fullest = null;
+            for (int i = 0; i < m_Parked.Count(); i++)
+            {
+                ref array<EntityAI> parked = m_Parked.GetElement(i);
+                if (!fullest || parked.Count() > fullest.Count())
+                    fullest = parked;
+            }
+            
+            EntityAI entity = fullest.Get(fullest.Count() - 1);
+            fullest.Remove(fullest.Count() - 1);
+            m_ParkedCount--;
+            count--;
+            
+            if (entity)
+            {
+                entity.Delete();
+            }
+        }
+    }
+    
+    // Returns false if the entity could not be parked and should be deleted instead
+    bool Park(EntityAI entity)
+    {
+        if (!IsEnabled() || m_ParkedCount >= m_Capacity)
+            return false;
         
-        ref SpawnPointConfig sp2 = new SpawnPointConfig();
-        sp2.position = "6565 15 2635";
-        sp2.radius = 2.0;
-        sp2.tierIds.Insert(1);
-        sp2.tierIds.Insert(2);
-        sp2.entities = 1;
-        sp2.useFixedHeight = false;
-        zone1.spawnPoints.Insert(sp2);
+        if (!entity || !entity.IsAlive())
+            return false;
         
-        ref SpawnPointConfig sp3 = new SpawnPointConfig();
-        sp3.position = "6558 18.5 2628";
-        sp3.radius = 1.0;
-        sp3.tierIds.Insert(2);
-        sp3.entities = 3;
-        sp3.useFixedHeight = true;
-        zone1.spawnPoints.Insert(sp3);
+        DayZCreatureAI creature = DayZCreatureAI.Cast(entity);
+        if (creature)
+        {
+            creature.DestroyAIAgent();
+        }
         
-        container.zones.Insert(zone1);
+        entity.SetPosition(m_HoldingPosition);
+        entity.DisableSimulation(true);
+        GetGame().RemoteObjectTreeDelete(entity);
         
-        // Zone 2: Underground Bunker Example
-        ref ZoneConfig zone2 = new ZoneConfig();
-        zone2.name = "Test_Zone_Underground_Bunker";
-        zone2.enabled = true;
-        zone2.position = "-1000 -50 -1000";
-        zone2.triggerRadius = 80;
-        zone2.spawnChance = 0.5;
-        zone2.despawnOnExit = true;
-        zone2.despawnDistance = 120;
+        ref array<EntityAI> parked;
+        if (!m_Parked.Find(entity.GetType(), parked))
+        {
+            parked = new array<EntityAI>;
+            m_Parked.Set(entity.GetType(), parked);
+        }
+        parked.Insert(entity);
+        m_ParkedCount++;
+        return true;
+    }
+    
+    // Returns a parked entity moved to position with full health and fresh AI, or null on a miss
+    EntityAI Acquire(string classname, vector position)
+    {
+        ref array<EntityAI> parked;
+        if (m_Parked.Find(classname, parked))
+        {
+            while (parked.Count() > 0)
+            {
+                EntityAI entity = parked.Get(parked.Count() - 1);
+                parked.Remove(parked.Count() - 1);
+                m_ParkedCount--;
+                
+                // Deleted by the engine or killed while parked
+                if (!entity || !entity.IsAlive())
+                    continue;
+                
+                entity.SetPosition(position);
+                entity.SetOrientation(Vector(Math.RandomFloat(0, 360), 0, 0));
+                entity.SetHealth("", "", entity.GetMaxHealth("", ""));
+                entity.DisableSimulation(false);
+                
+                DayZCreatureAI creature = DayZCreatureAI.Cast(entity);
+                if (creature)
+                {
+                    creature.InitAIAgent(GetGame().GetWorld().GetAIWorld().CreateDefaultGroup());
+                }
+                
+                GetGame().RemoteObjectTreeCreate(entity);
+                m_Hits++;
+                return entity;
+            }
+        }
+        
+        m_Misses++;
+        return null;
+    }
+}
+
+// Multi-level grid over zone reach circles. Each zone is stored on the finest level whose cells are
+// at least as wide as its circle, so it overlaps at most 2x2 cells there, and a query probes one
+// cell per populated level. Keys pack level and offset cell coordinates into a non-negative int,
+// so cells never collide within +/-CELL_OFFSET cells of the origin (260 km at the finest level).
+class SimpleZoneIndex : Managed
+{
+    static const float BASE_CELL_SIZE = 32.0;
+    static const int LEVEL_COUNT = 6;  // 32 m to 32 km cells, x4 per level
+    static const int CELL_BITS = 14;
+    static const int CELL_OFFSET = 8192;
+    
+    ref map<int, ref array<SimpleZone>> m_Cells;
+    ref array<float> m_CellSizes;
+    ref array<int> m_LevelZoneCounts;
+    int m_ZoneCount;
+    
+    void SimpleZoneIndex()
+    {
+        m_Cells = new map<int, ref array<SimpleZone>>;
+        m_CellSizes = new array<float>;
+        m_LevelZoneCounts = new array<int>;
+        
+        float size = BASE_CELL_SIZE;
+        for (int level = 0; level < LEVEL_COUNT; level++)
+        {
+            m_CellSizes.Insert(size);
+            m_LevelZoneCounts.Insert(0);
+            size = size * 4.0;
+        }
+        m_ZoneCount = 0;
+    }
+    
+    void Clear()
+    {
+        m_Cells.Clear();
+        for (int level = 0; level < LEVEL_COUNT; level++)
+        {
+            m_LevelZoneCounts.Set(level, 0);
+        }
+        m_ZoneCount = 0;
+    }
+    
+    int MakeKey(int level, int cellX, int cellZ)
+    {
+        cellX = Math.Clamp(cellX, -CELL_OFFSET, CELL_OFFSET - 1) + CELL_OFFSET;
+        cellZ = Math.Clamp(cellZ, -CELL_OFFSET, CELL_OFFSET - 1) + CELL_OFFSET;
+        return (level << (CELL_BITS * 2)) | (cellX << CELL_BITS) | cellZ;
+    }
+    
+    int GetCellKey(int level, vector pos)
+    {
+        float size = m_CellSizes.Get(level);
+        int cellX = Math.Floor(pos[0] / size);
+        int cellZ = Math.Floor(pos[2] / size);
+        return MakeKey(level, cellX, cellZ);
+    }
+    
+    // Key of the finest populated cell containing pos, used to notice players crossing cells
+    int GetPlayerCellKey(vector pos)
+    {
+        for (int level = 0; level < LEVEL_COUNT; level++)
+        {
+            if (m_LevelZoneCounts.Get(level) > 0)
+                return GetCellKey(level, pos);
+        }
+        return GetCellKey(0, pos);
+    }
+    
+    void Insert(SimpleZone zone, vector center, float radius)
+    {
+        array<int> cells = new array<int>;
+        ComputeCells(center, radius, cells);
+        InsertCells(zone, radius, cells);
+    }
+    
+    void ComputeCells(vector position, float radius, array<int> cells)
+    {
+        int level = 0;
+        while (level < LEVEL_COUNT - 1 && m_CellSizes.Get(level) < radius * 2.0)
+        {
+            level++;
+        }
+        
+        float size = m_CellSizes.Get(level);
+        int minX = Math.Floor((position[0] - radius) / size);
+        int maxX = Math.Floor((position[0] + radius) / size);
+        int minZ = Math.Floor((position[2] - radius) / size);
+        int maxZ = Math.Floor((position[2] + radius) / size);
+        
+        for (int x = minX; x <= maxX; x++)
+        {
+            for (int z = minZ; z <= maxZ; z++)
+            {
+                cells.Insert(MakeKey(level, x, z));
+            }
+        }
+    }
+    
+    // Inserts a zone into precomputed cells, e.g. ones restored from the compiled cache
+    void InsertCells(SimpleZone zone, float radius, array<int> cells)
+    {
+        if (cells.Count() == 0)
+            return;
+        
+        array<int> keys = cells;
+        if (cells == zone.indexCells)
+        {
+            keys = new array<int>;
+            keys.Copy(cells);
+        }
+        
+        zone.isIndexed = true;
+        zone.indexRadius = radius;
+        zone.indexCells.Clear();
+        
+        for (int i = 0; i < keys.Count(); i++)
+        {
+            int key = keys.Get(i);
+            
+            ref array<SimpleZone> cellZones;
+            if (!m_Cells.Find(key, cellZones))
+            {
+                cellZones = new array<SimpleZone>;
+                m_Cells.Set(key, cellZones);
+            }
+            cellZones.Insert(zone);
+            zone.indexCells.Insert(key);
+        }
+        
+        int level = keys.Get(0) >> (CELL_BITS * 2);
+        m_LevelZoneCounts.Set(level, m_LevelZoneCounts.Get(level) + 1);
+        m_ZoneCount++;
+    }
+    
+    void Remove(SimpleZone zone)
+    {
+        if (!zone.isIndexed)
+            return;
+        
+        int level = zone.indexCells.Get(0) >> (CELL_BITS * 2);
+        
+        for (int i = 0; i < zone.indexCells.Count(); i++)
+        {
+            int key = zone.indexCells.Get(i);
+            
+            ref array<SimpleZone> cellZones;
+            if (m_Cells.Find(key, cellZones))
+            {
+                cellZones.RemoveItem(zone);
+                if (cellZones.Count() == 0)
+                    m_Cells.Remove(key);
+            }
+        }
+        
+        zone.isIndexed = false;
+        zone.indexCells.Clear();
+        m_LevelZoneCounts.Set(level, m_LevelZoneCounts.Get(level) - 1);
+        m_ZoneCount--;
+    }
+    
+    // Appends exactly the zones whose reach circle contains pos (XZ plane)
+    void Query(vector pos, array<SimpleZone> results)
+    {
+        for (int level = 0; level < LEVEL_COUNT; level++)
+        {
+            if (m_LevelZoneCounts.Get(level) == 0)
+                continue;
+            
+            ref array<SimpleZone> cellZones;
+            if (!m_Cells.Find(GetCellKey(level, pos), cellZones))
+                continue;
+            
+            for (int i = 0; i < cellZones.Count(); i++)
+            {
+                SimpleZone zone = cellZones.Get(i);
+                float dx = pos[0] - zone.position[0];
+                float dz = pos[2] - zone.position[2];
+                if ((dx * dx) + (dz * dz) <= zone.indexRadius * zone.indexRadius)
+                {
+                    results.Insert(zone);
+                }
+            }
+        }
+    }
+    
+    int GetCellCount()
+    {
+        return m_Cells.Count();
+    }
+    
+    int GetLevelCount()
+    {
+        int populated = 0;
+        for (int level = 0; level < LEVEL_COUNT; level++)
+        {
+            if (m_LevelZoneCounts.Get(level) > 0)
+                populated++;
+        }
+        return populated;
+    }
+}
+
+// Positions of all living players at the latest check, bucketed in a uniform XZ grid so
+// proximity tests only visit nearby cells. Cell arrays are kept and cleared in place.
+class SimplePlayerGrid : Managed
+{
+    static const float CELL_SIZE = 100.0;
+    static const int CELL_BITS = 14;
+    static const int CELL_OFFSET = 8192;
+    
+    ref array<vector> m_Positions;
+    ref map<int, ref array<int>> m_Cells;
+    ref array<int> m_UsedKeys;
+    
+    void SimplePlayerGrid()
+    {
+        m_Positions = new array<vector>;
+        m_Cells = new map<int, ref array<int>>;
+        m_UsedKeys = new array<int>;
+    }
+    
+    int MakeKey(int cx, int cz)
+    {
+        return ((cx + CELL_OFFSET) << CELL_BITS) | (cz + CELL_OFFSET);
+    }
+    
+    int GetCellCoord(float value)
+    {
+        return Math.Floor(value / CELL_SIZE);
+    }
+    
+    void Build(array<ref SimplePlayerSample> samples, int count)
+    {
+        for (int k = 0; k < m_UsedKeys.Count(); k++)
+        {
+            m_Cells.Get(m_UsedKeys.Get(k)).Clear();
+        }
+        m_UsedKeys.Clear();
+        m_Positions.Clear();
+        
+        for (int i = 0; i < count; i++)
+        {
+            vector pos = samples.Get(i).position;
+            m_Positions.Insert(pos);
+            
+            int key = MakeKey(GetCellCoord(pos[0]), GetCellCoord(pos[2]));
+            ref array<int> cell;
+            if (!m_Cells.Find(key, cell))
+            {
+                cell = new array<int>;
+                m_Cells.Set(key, cell);
+            }
+            
+            if (cell.Count() == 0)
+                m_UsedKeys.Insert(key);
+            
+            cell.Insert(i);
+        }
+    }
+    
+    int Count()
+    {
+        return m_Positions.Count();
+    }
+    
+    // Squared 3D distance to the closest player within radius, or -1 if there is none
+    float ClosestDistanceSq(vector pos, float radius)
+    {
+        float closest = -1;
+        float radiusSq = radius * radius;
+        
+        int minX = GetCellCoord(pos[0] - radius);
+        int maxX = GetCellCoord(pos[0] + radius);
+        int minZ = GetCellCoord(pos[2] - radius);
+        int maxZ = GetCellCoord(pos[2] + radius);
+        
+        for (int cx = minX; cx <= maxX; cx++)
+        {
+            for (int cz = minZ; cz <= maxZ; cz++)
+            {
+                ref array<int> cell;
+                if (!m_Cells.Find(MakeKey(cx, cz), cell))
+                    continue;
+                
+                for (int i = 0; i < cell.Count(); i++)
+                {
+                    float distSq = vector.DistanceSq(m_Positions.Get(cell.Get(i)), pos);
+                    if (distSq <= radiusSq && (closest < 0 || distSq < closest))
+                        closest = distSq;
+                }
+            }
+        }
+        
+        return closest;
+    }
+    
+    bool AnyWithin(vector pos, float radius)
+    {
+        return ClosestDistanceSq(pos, radius) >= 0;
+    }
+}
+
+// Levelled log for the spawn system. Messages below the level are dropped before they are
+// formatted. Kept lines go to a ring buffer for on-demand dumps and are appended to the log
+// file in batches; INFO and above are also echoed to the script log.
+class SimpleLogger : Managed
+{
+    static const int LEVEL_ERROR = 0;
+    static const int LEVEL_WARNING = 1;
+    static const int LEVEL_INFO = 2;
+    static const int LEVEL_DEBUG = 3;
+    
+    static const int RING_SIZE = 256;
+    static const int FLUSH_BATCH = 64;
+    static const float FLUSH_INTERVAL = 10.0;
+    static const string LOG_DIR = "$profile:MutantSpawnSystem";
+    static const string LOG_PATH = "$profile:MutantSpawnSystem/SpawnSystem.log";
+    static const string PREVIOUS_LOG_PATH = "$profile:MutantSpawnSystem/SpawnSystem.previous.log";
+    
+    int m_Level;
+    ref array<string> m_Ring;
+    int m_RingNext;
+    ref array<string> m_Pending;
+    float m_FlushTimer;
+    
+    void SimpleLogger()
+    {
+        m_Level = LEVEL_INFO;
+        m_Ring = new array<string>;
+        m_RingNext = 0;
+        m_Pending = new array<string>;
+        m_FlushTimer = 0;
+        
+        RotateLogFile();
+    }
+    
+    // One log per server run; the previous run's log is kept, older ones are dropped
+    void RotateLogFile()
+    {
+        if (!FileExist(LOG_PATH))
+            return;
+        
+        if (FileExist(PREVIOUS_LOG_PATH))
+            DeleteFile(PREVIOUS_LOG_PATH);
+        
+        CopyFile(LOG_PATH, PREVIOUS_LOG_PATH);
+        DeleteFile(LOG_PATH);
+    }
+    
+    void SetLevel(int level)
+    {
+        m_Level = Math.Clamp(level, LEVEL_ERROR, LEVEL_DEBUG);
+    }
+    
+    bool IsEnabled(int level)
+    {
+        return level <= m_Level;
+    }
+    
+    void Error(string fmt, void param1 = NULL, void param2 = NULL, void param3 = NULL, void param4 = NULL, void param5 = NULL)
+    {
+        if (m_Level >= LEVEL_ERROR)
+            Write(LEVEL_ERROR, string.Format(fmt, param1, param2, param3, param4, param5));
+    }
+    
+    void Warning(string fmt, void param1 = NULL, void param2 = NULL, void param3 = NULL, void param4 = NULL, void param5 = NULL)
+    {
+        if (m_Level >= LEVEL_WARNING)
+            Write(LEVEL_WARNING, string.Format(fmt, param1, param2, param3, param4, param5));
+    }
+    
+    void Info(string fmt, void param1 = NULL, void param2 = NULL, void param3 = NULL, void param4 = NULL, void param5 = NULL)
+    {
+        if (m_Level >= LEVEL_INFO)
+            Write(LEVEL_INFO, string.Format(fmt, param1, param2, param3, param4, param5));
+    }
+    
+    void Debug(string fmt, void param1 = NULL, void param2 = NULL, void param3 = NULL, void param4 = NULL, void param5 = NULL)
+    {
+        if (m_Level >= LEVEL_DEBUG)
+            Write(LEVEL_DEBUG, string.Format(fmt, param1, param2, param3, param4, param5));
+    }
+    
+    string GetLevelName(int level)
+    {
+        switch (level)
+        {
+            case LEVEL_ERROR: return "ERROR";
+            case LEVEL_WARNING: return "WARNING";
+            case LEVEL_INFO: return "INFO";
+        }
+        return "DEBUG";
+    }
+    
+    void Write(int level, string message)
+    {
+        string line = GetLevelName(level) + " " + message;
+        
+        if (level <= LEVEL_INFO)
+            Print("[SpawnManager] " + line);
+        
+        if (m_Ring.Count() < RING_SIZE)
+            m_Ring.Insert(line);
+        else
+            m_Ring.Set(m_RingNext, line);
+        m_RingNext = (m_RingNext + 1) % RING_SIZE;
+        
+        m_Pending.Insert(line);
+        if (m_Pending.Count() >= FLUSH_BATCH)
+            Flush();
+    }
+    
+    void Update(float timeslice)
+    {
+        m_FlushTimer += timeslice;
+        if (m_FlushTimer >= FLUSH_INTERVAL)
+        {
+            m_FlushTimer = 0;
+            Flush();
+        }
+    }
+    
+    void Flush()
+    {
+        if (m_Pending.Count() == 0)
+            return;
+        
+        if (!FileExist(LOG_DIR))
+        {
+            MakeDirectory(LOG_DIR);
+        }
+        
+        FileHandle file = OpenFile(LOG_PATH, FileMode.APPEND);
+        if (file != 0)
+        {
+            for (int i = 0; i < m_Pending.Count(); i++)
+            {
+                FPrintln(file, m_Pending.Get(i));
+            }
+            CloseFile(file);
+        }
+        
+        m_Pending.Clear();
+    }
+    
+    // Prints up to count of the most recent lines to the script log, oldest first
+    void DumpRecent(int count)
+    {
+        int total = Math.Min(count, m_Ring.Count());
+        int start = m_RingNext - total;
+        if (start < 0)
+            start += m_Ring.Count();
+        
+        Print("[SpawnManager] === LAST " + total.ToString() + " LOG LINES ===");
+        for (int i = 0; i < total; i++)
+        {
+            Print("[SpawnLog] " + m_Ring.Get((start + i) % m_Ring.Count()));
+        }
+    }
+}
+
+static ref SimpleLogger g_SpawnLog;
+
+SimpleLogger SpawnLog()
+{
+    if (!g_SpawnLog)
+        g_SpawnLog = new SimpleLogger();
+    
+    return g_SpawnLog;
+}
+
+// Call count, timing and work counters of one instrumented phase since the last flush
+class SimplePhaseStats : Managed
+{
+    string name;
+    int calls;
+    float totalMs;
+    float maxMs;
+    int zones;
+    int players;
+    int entities;
+    ref array<int> histogram;  // Calls per bucket of SimpleMetrics.BUCKET_LIMITS_MS, last bucket is open-ended
+    
+    void SimplePhaseStats(string phaseName)
+    {
+        name = phaseName;
+        histogram = new array<int>;
+        for (int i = 0; i <= SimpleMetrics.BUCKET_COUNT; i++)
+        {
+            histogram.Insert(0);
+        }
+        Reset();
+    }
+    
+    void Reset()
+    {
+        calls = 0;
+        totalMs = 0;
+        maxMs = 0;
+        zones = 0;
+        players = 0;
+        entities = 0;
+        for (int i = 0; i < histogram.Count(); i++)
+        {
+            histogram.Set(i, 0);
+        }
+    }
+}
+
+// Per-phase counters that are cheap to update on the hot path and appended to a CSV file
+// on each flush, one row per phase
+class SimpleMetrics : Managed
+{
+    static const int PHASE_CHECK_PLAYERS = 0;
+    static const int PHASE_CHECK_ZONE = 1;      // Includes the spawn or despawn it triggers
+    static const int PHASE_TRY_SPAWN = 2;
+    static const int PHASE_DESPAWN = 3;
+    static const int PHASE_CLEANUP = 4;
+    static const int PHASE_DESPAWN_QUEUE = 5;   // One 50 ms drain tick of the despawn queue
+    static const int PHASE_COUNT = 6;
+    
+    static const int BUCKET_COUNT = 6;
+    static const string METRICS_DIR = "$profile:MutantSpawnSystem/metrics";
+    static const string METRICS_PATH = "$profile:MutantSpawnSystem/metrics/phases.csv";
+    
+    ref array<ref SimplePhaseStats> m_Phases;
+    ref array<float> m_BucketLimits;
+    
+    void SimpleMetrics()
+    {
+        m_Phases = new array<ref SimplePhaseStats>;
+        m_Phases.Insert(new SimplePhaseStats("CheckPlayersOptimized"));
+        m_Phases.Insert(new SimplePhaseStats("CheckZone"));
+        m_Phases.Insert(new SimplePhaseStats("TrySpawnInZone"));
+        m_Phases.Insert(new SimplePhaseStats("DespawnFromZone"));
+        m_Phases.Insert(new SimplePhaseStats("CleanupDeadEntities"));
+        m_Phases.Insert(new SimplePhaseStats("ProcessDespawnQueue"));
+        
+        // Upper bounds in ms, BUCKET_COUNT entries
+        m_BucketLimits = {0.05, 0.2, 0.5, 1.0, 2.0, 5.0};
+    }
+    
+    // Records one call taking the given time, started with TickCount(0)
+    void Record(int phase, int startTicks)
+    {
+        RecordMs(phase, TickCount(startTicks) / 10000.0);
+    }
+    
+    void RecordMs(int phase, float ms)
+    {
+        SimplePhaseStats stats = m_Phases.Get(phase);
+        stats.calls++;
+        stats.totalMs += ms;
+        if (ms > stats.maxMs)
+            stats.maxMs = ms;
+        
+        int bucket = 0;
+        while (bucket < BUCKET_COUNT && ms > m_BucketLimits.Get(bucket))
+        {
+            bucket++;
+        }
+        stats.histogram.Set(bucket, stats.histogram.Get(bucket) + 1);
+    }
+    
+    void AddWork(int phase, int zones, int players, int entities)
+    {
+        SimplePhaseStats stats = m_Phases.Get(phase);
+        stats.zones += zones;
+        stats.players += players;
+        stats.entities += entities;
+    }
+    
+    SimplePhaseStats Get(int phase)
+    {
+        return m_Phases.Get(phase);
+    }
+    
+    // Appends one row per phase and starts a new window
+    void Flush(int timestamp, float windowSeconds)
+    {
+        if (!FileExist(METRICS_DIR))
+        {
+            MakeDirectory(METRICS_DIR);
+        }
+        
+        bool writeHeader = !FileExist(METRICS_PATH);
+        FileHandle file = OpenFile(METRICS_PATH, FileMode.APPEND);
+        if (file == 0)
+        {
+            SpawnLog().Warning("Could not write metrics file");
+            return;
+        }
+        
+        if (writeHeader)
+        {
+            string header = "timestamp,window_s,phase,calls,total_ms,avg_ms,max_ms,zones,players,entities";
+            for (int b = 0; b < BUCKET_COUNT; b++)
+            {
+                header += ",le_" + m_BucketLimits.Get(b).ToString() + "ms";
+            }
+            header += ",gt_" + m_BucketLimits.Get(BUCKET_COUNT - 1).ToString() + "ms";
+            FPrintln(file, header);
+        }
+        
+        for (int i = 0; i < m_Phases.Count(); i++)
+        {
+            SimplePhaseStats stats = m_Phases.Get(i);
+            
+            float avgMs = 0;
+            if (stats.calls > 0)
+                avgMs = stats.totalMs / stats.calls;
+            
+            string row = timestamp.ToString() + "," + windowSeconds.ToString() + "," + stats.name + "," + stats.calls.ToString();
+            row += "," + stats.totalMs.ToString() + "," + avgMs.ToString() + "," + stats.maxMs.ToString();
+            row += "," + stats.zones.ToString() + "," + stats.players.ToString() + "," + stats.entities.ToString();
+            for (int h = 0; h < stats.histogram.Count(); h++)
+            {
+                row += "," + stats.histogram.Get(h).ToString();
+            }
+            FPrintln(file, row);
+            
+            stats.Reset();
+        }
+        
+        CloseFile(file);
+    }
+}
+
+// Id and position of a living player, as seen by one check
+class SimplePlayerSample : Managed
+{
+    int id;
+    vector position;
+}
+
+// The engine calls the manager depends on. The default implementation forwards to the game;
+// the simulation harness substitutes a synthetic world.
+class SimpleSpawnWorld : Managed
+{
+    static const int KIND_INVALID = 0;
+    static const int KIND_CREATURE = 1;
+    static const int KIND_ANIMAL = 2;
+    static const int KIND_OTHER = 3;
+    
+    static const float NAVMESH_SEARCH_RADIUS = 1.5;
+    static const vector CREATURE_BOX = "0.8 1.8 0.8";
+    
+    ref array<Man> m_PlayerScratch = new array<Man>;
+    
+    // Writes all living players into samples, reusing its entries, and returns how many were
+    // written. Entries past the returned count are stale.
+    int GetPlayerSamples(array<ref SimplePlayerSample> samples)
+    {
+        m_PlayerScratch.Clear();
+        GetGame().GetPlayers(m_PlayerScratch);
+        
+        int count = 0;
+        for (int i = 0; i < m_PlayerScratch.Count(); i++)
+        {
+            Man player = m_PlayerScratch.Get(i);
+            if (!player || !player.IsAlive())
+                continue;
+            
+            SimplePlayerSample sample = GetSampleSlot(samples, count);
+            sample.id = player.GetID();
+            sample.position = player.GetPosition();
+            count++;
+        }
+        
+        m_PlayerScratch.Clear();
+        return count;
+    }
+    
+    SimplePlayerSample GetSampleSlot(array<ref SimplePlayerSample> samples, int index)
+    {
+        if (index < samples.Count())
+            return samples.Get(index);
+        
+        SimplePlayerSample sample = new SimplePlayerSample();
+        samples.Insert(sample);
+        return sample;
+    }
+    
+    EntityAI CreateEntity(string type, vector position)
+    {
+        return EntityAI.Cast(GetGame().CreateObject(type, position, false, true, true));
+    }
+    
+    void DeleteEntity(EntityAI entity)
+    {
+        entity.Delete();
+    }
+    
+    float SurfaceY(float x, float z)
+    {
+        return GetGame().SurfaceY(x, z);
+    }
+    
+    // Snaps a ground position onto the navmesh and rejects it if a creature would not fit there
+    bool ValidateSpawnPosition(vector position, out vector resolved)
+    {
+        resolved = position;
+        
+        PGFilter filter = new PGFilter();
+        filter.SetFlags(PGPolyFlags.WALK, PGPolyFlags.DISABLED | PGPolyFlags.SWIM | PGPolyFlags.SWIM_SEA, 0);
+        
+        AIWorld aiWorld = GetGame().GetWorld().GetAIWorld();
+        if (!aiWorld.SampleNavmeshPosition(position, NAVMESH_SEARCH_RADIUS, filter, resolved))
+            return false;
+        
+        vector center = resolved + Vector(0, CREATURE_BOX[1] * 0.5 + 0.1, 0);
+        if (GetGame().IsBoxColliding(center, vector.Zero, CREATURE_BOX, null, null))
+            return false;
+        
+        return true;
+    }
+    
+    // Looks the classname up in the config tree
+    int ClassifySpawnable(string classname)
+    {
+        if (!GetGame().ConfigIsExisting("CfgVehicles " + classname))
+            return KIND_INVALID;
+        
+        if (GetGame().IsKindOf(classname, "DayZInfected"))
+            return KIND_CREATURE;
+        
+        if (GetGame().IsKindOf(classname, "DayZAnimal"))
+            return KIND_ANIMAL;
+        
+        return KIND_OTHER;
+    }
+    
+    ScriptCallQueue GetCallQueue()
+    {
+        return GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM);
+    }
+}
+
+// ============= PART 2: OPTIMIZED SPAWN MANAGER =============
+
+class SimpleSpawnManager : Managed
+{
+    bool m_SystemEnabled;
+    float m_Time;  // Seconds the system has been running, drives cooldowns
+    float m_CheckTimer;
+    float m_CheckInterval;
+    
+    // Adaptive check interval inputs, gathered during each check
+    int m_PlayersNearBorder;  // Counted by CheckZone, so time-sliced cycles report at the next check
+    int m_FastPlayers;
+    int m_PlayersOnline;
+    float m_MaxTimeslice;  // Longest update step since the last check
+    float m_LastCheckMs;
+    static const int UPDATE_INTERVAL_MS = 1000;
+    static const float BORDER_MARGIN = 30.0;      // Players this close to a trigger radius count as near the border
+    static const float FAST_PLAYER_SPEED = 8.0;   // m/s, roughly a sprint
+
+    float m_MinSpawnDistanceFromPlayer;
+    
+    ref map<int, ref SimpleTier> m_Tiers;
+    ref map<string, ref SimpleZone> m_ZonesMap;  // Lookups by name, for reloads and admin commands
+    ref GlobalSettingsConfig m_GlobalSettings;
+    
+    // Hot zone fields as parallel arrays indexed by SimpleZone.id, so distance loops read
+    // contiguous floats instead of chasing zone objects
+    ref array<SimpleZone> m_ZoneList;
+    ref array<float> m_ZoneX;
+    ref array<float> m_ZoneY;
+    ref array<float> m_ZoneZ;
+    ref array<float> m_ZoneTriggerSq;
+    ref array<float> m_ZoneExitSq;
+    ref array<float> m_ZoneDespawnSq;
+    ref array<float> m_ZoneReach;
+    ref array<float> m_ZoneReachSq;
+    ref array<float> m_ZoneBorderInnerSq;  // Band around the trigger radius counted as near the border
+    ref array<float> m_ZoneBorderOuterSq;
+    ref array<bool> m_ZoneEnabled;
+    
+    // Spatial optimization
+    ref SimpleZoneIndex m_ZoneIndex;
+    
+    // Compiled config cache, bump the version whenever the layout or index parameters change
+    static const string TIERS_PATH = "$profile:MutantSpawnSystem/Tiers.json";
+    static const string ZONES_PATH = "$profile:MutantSpawnSystem/Zones.json";
+    static const string CACHE_PATH = "$profile:MutantSpawnSystem/ZonesCache.bin";
+    static const int CACHE_VERSION = 3;
+    
+    // Zone runtime state kept across restarts, cooldowns are stored as wall-clock expiry
+    static const string STATE_PATH = "$profile:MutantSpawnSystem/ZoneState.bin";
+    static const int STATE_VERSION = 1;
+    float m_SnapshotTimer;
+    bool m_StateRestored;
+    
+    // Classname -> SimpleSpawnWorld.KIND_*, the config tree does not change while the server runs
+    ref map<string, int> m_SpawnableKinds;
+    
+    // Despawned entities, deleted within the per-tick despawn budget farthest-from-players first.
+    // They are untracked when queued; their zones do not spawn again until their entries drain.
+    ref SimpleMinHeap m_DespawnQueue;
+    bool m_DespawnPumpActive;
+    static const int DESPAWN_QUEUE_TICK_MS = 50;
+    static const float DESPAWN_PRIORITY_RADIUS = 500.0;
+    
+    ref SimpleSpawnWorld m_World;
+    bool m_IsSimulation;  // Driven by an injected world; leaves process-wide state alone
+    
+    // Incremental player -> zone membership
+    ref array<ref SimplePlayerSample> m_PlayerSamples;
+    ref SimplePlayerGrid m_PlayerGrid;
+    
+    // Scratch buffers of the check path, cleared in place so a check allocates nothing
+    ref array<SimpleZone> m_DirtyZones;
+    ref array<SimpleZone> m_QueryResults;
+    ref array<int> m_GoneIds;
+    
+    // Time-sliced zone evaluation: the zones of the current cycle, worked off across ticks
+    ref array<SimpleZone> m_ZoneWorkList;
+    int m_ZoneWorkCursor;
+    bool m_ZoneWorkPumpActive;
+    float m_ZoneWorkMs;  // Slice time since the last check, added to that check's cost
+    static const int ZONE_WORK_TICK_MS = 50;
+    ref map<int, ref SimplePlayerState> m_PlayerStates;
+    ref array<SimpleZone> m_ActiveZones;  // Zones with players in reach, always re-checked for exits
+    int m_CheckEpoch;
+    static const float PLAYER_MOVE_THRESHOLD = 20.0;  // Re-query the grid after moving this far
+    
+    // Spawn position candidates
+    static const int MAX_SPAWN_CANDIDATES = 16;
+    static const int CANDIDATE_ATTEMPTS = 8;        // Dart throws per wanted candidate
+    static const float MIN_CANDIDATE_SPACING = 1.5;
+    
+    static const float VIRTUAL_DRIFT_SECONDS = 120.0;  // Virtual creatures idle this long return to their spawn point
+    
+    // Frame-budgeted spawning
+    ref SimpleMinHeap m_SpawnQueue;  // Nearest-to-player jobs first
+    bool m_SpawnPumpActive;
+    static const int SPAWN_QUEUE_TICK_MS = 50;
+    int m_ReclaimedEntities;  // Creatures removed to make room under maxTotalEntities
+    
+    // Per-phase instrumentation
+    ref SimpleMetrics m_Metrics;
+    float m_MetricsTimer;
+    
+    // Zone cooldowns ordered by expiry; entries made stale by a newer cooldown are skipped on pop
+    ref SimpleMinHeap m_Cooldowns;
+    
+    // Entity recycling
+    ref SimpleEntityPool m_EntityPool;
+    
+    // Entity lifetimes
+    ref SimpleTimerWheel m_LifetimeWheel;
+    ref array<ref SimpleSpawnedEntity> m_ExpiredEntities;
+    
+    // Spawned entities by engine id, so death and deletion events resolve in O(1)
+    ref map<int, SimpleSpawnedEntity> m_TrackedEntities;
+    static const int CONSISTENCY_SWEEP_INTERVAL = 600000;  // Fallback for entities without event hooks
+    
+    // The game world is used unless a world is injected. An injected world is driven by its
+    // owner, which loads zones and calls Update itself.
+    void SimpleSpawnManager(SimpleSpawnWorld world = null)
+    {
+        m_SystemEnabled = true;
+        m_Time = 0.0;
+        m_CheckTimer = 0.0;
+        m_CheckInterval = 5.0;  // Check more often but smarter
+        m_PlayersNearBorder = 0;
+        m_FastPlayers = 0;
+        m_PlayersOnline = 0;
+        m_MaxTimeslice = 0;
+        m_LastCheckMs = 0;
+        m_MinSpawnDistanceFromPlayer = 30.0;
+        m_SnapshotTimer = 0;
+        m_StateRestored = false;
+        
+        m_Tiers = new map<int, ref SimpleTier>;
+        m_SpawnableKinds = new map<string, int>;
+        m_ZonesMap = new map<string, ref SimpleZone>;
+        m_ZoneList = new array<SimpleZone>;
+        m_ZoneX = new array<float>;
+        m_ZoneY = new array<float>;
+        m_ZoneZ = new array<float>;
+        m_ZoneTriggerSq = new array<float>;
+        m_ZoneExitSq = new array<float>;
+        m_ZoneDespawnSq = new array<float>;
+        m_ZoneReach = new array<float>;
+        m_ZoneReachSq = new array<float>;
+        m_ZoneBorderInnerSq = new array<float>;
+        m_ZoneBorderOuterSq = new array<float>;
+        m_ZoneEnabled = new array<bool>;
+        m_ZoneIndex = new SimpleZoneIndex();
+        m_GlobalSettings = new GlobalSettingsConfig;
+        m_PlayerSamples = new array<ref SimplePlayerSample>;
+        m_PlayerGrid = new SimplePlayerGrid();
+        m_DirtyZones = new array<SimpleZone>;
+        m_QueryResults = new array<SimpleZone>;
+        m_GoneIds = new array<int>;
+        m_ZoneWorkList = new array<SimpleZone>;
+        m_ZoneWorkCursor = 0;
+        m_ZoneWorkPumpActive = false;
+        m_ZoneWorkMs = 0;
+        m_PlayerStates = new map<int, ref SimplePlayerState>;
+        m_ActiveZones = new array<SimpleZone>;
+        m_CheckEpoch = 0;
+        m_SpawnQueue = new SimpleMinHeap();
+        m_SpawnPumpActive = false;
+        m_ReclaimedEntities = 0;
+        m_Metrics = new SimpleMetrics();
+        m_MetricsTimer = 0;
+        m_Cooldowns = new SimpleMinHeap();
+        m_EntityPool = new SimpleEntityPool();
+        m_LifetimeWheel = new SimpleTimerWheel();
+        m_ExpiredEntities = new array<ref SimpleSpawnedEntity>;
+        m_TrackedEntities = new map<int, SimpleSpawnedEntity>;
+        m_DespawnQueue = new SimpleMinHeap();
+        m_DespawnPumpActive = false;
+        m_IsSimulation = false;
+        
+        if (world)
+        {
+            m_World = world;
+            m_IsSimulation = true;
+            return;
+        }
+        
+        m_World = new SimpleSpawnWorld();
+        
+        SpawnLog().Info("=== OPTIMIZED SPAWN SYSTEM v2.0 INITIALIZED ===");
+        
+        m_World.GetCallQueue().CallLater(CreateDefaultConfigs, 3000, false);
+        m_World.GetCallQueue().CallLater(LoadAllConfigs, 8000, false);
+        m_World.GetCallQueue().CallLater(CleanupDeadEntities, CONSISTENCY_SWEEP_INTERVAL, true);
+    }
+    
+    void CreateDefaultConfigs()
+    {
+        string configDir = "$profile:MutantSpawnSystem";
+        
+        if (!FileExist(configDir))
+        {
+            MakeDirectory(configDir);
+            SpawnLog().Info("Created config directory");
+        }
+        
+        string tiersPath = "$profile:MutantSpawnSystem/Tiers.json";
+        if (!FileExist(tiersPath))
+        {
+            CreateDefaultTiers(tiersPath);
+        }
+        
+        string zonesPath = "$profile:MutantSpawnSystem/Zones.json";
+        if (!FileExist(zonesPath))
+        {
+            CreateDefaultZonesWithSpawnPoints(zonesPath);
+        }
+    }
+    
+    void CreateDefaultTiers(string filePath)
+    {
+        ref TiersContainer container = new TiersContainer();
+        
+        ref TierConfig tier1 = new TierConfig();
+        tier1.name = "Basic Zombies";
+        tier1.classnames.Insert("ZmbM_HunterOld_Autumn");
+        tier1.classnames.Insert("ZmbM_HunterOld_Spring");
+        tier1.classnames.Insert("ZmbF_SurvivorNormal_Blue");
+        tier1.classnames.Insert("ZmbF_SurvivorNormal_Red");
+        tier1.classnames.Insert("ZmbM_FarmerFat_Beige");
+        tier1.classnames.Insert("ZmbM_CitizenASkinny");
+        tier1.classnames.Insert("ZmbM_CitizenBFat");
+        container.tiers.Set(1, tier1);
+        
+        ref TierConfig tier2 = new TierConfig();
+        tier2.name = "Military Zombies";
+        tier2.classnames.Insert("ZmbM_SoldierNormal");
+        tier2.classnames.Insert("ZmbM_PatrolNormal_PautRev");
+        tier2.classnames.Insert("ZmbM_PatrolNormal_Autumn");
+        tier2.classnames.Insert("ZmbM_usSoldier_normal_Woodland");
+        container.tiers.Set(2, tier2);
+        
+        ref TierConfig tier3 = new TierConfig();
+        tier3.name = "Wildlife Predators";
+        tier3.classnames.Insert("Animal_UrsusArctos");
+        tier3.classnames.Insert("Animal_CanisLupus_Grey");
+        tier3.classnames.Insert("Animal_CanisLupus_White");
+        container.tiers.Set(3, tier3);
+        
+        JsonFileLoader<TiersContainer>.JsonSaveFile(filePath, container);
+        SpawnLog().Info("Created default Tiers.json");
+    }
+    
+    void CreateDefaultZonesWithSpawnPoints(string filePath)
+    {
+        ref ZonesContainer container = new ZonesContainer();
+        
+        container.globalSettings.systemEnabled = true;
+        container.globalSettings.checkInterval = 5.0;
+        container.globalSettings.maxEntitiesPerZone = 20;
+        container.globalSettings.entityLifetime = 600;
+        container.globalSettings.minSpawnDistanceFromPlayer = 30.0;
+        
+        // Zone 1: Urban Building Example
+        ref ZoneConfig zone1 = new ZoneConfig();
+        zone1.name = "Test_Zone_Cherno_Building";
+        zone1.enabled = true;
+        zone1.position = "6560 15 2630";
+        zone1.triggerRadius = 100;
+        zone1.spawnChance = 0.75;
+        zone1.despawnOnExit = true;
+        zone1.despawnDistance = 150;
+        zone1.respawnCooldown = 300;
+        
+        ref SpawnPointConfig sp1 = new SpawnPointConfig();
+        sp1.position = "6555 15 2625";
+        sp1.radius = 1.5;
+        sp1.tierIds.Insert(1);
+        sp1.entities = 2;
+        sp1.useFixedHeight = false;
+        zone1.spawnPoints.Insert(sp1);
+        
+        ref SpawnPointConfig sp2 = new SpawnPointConfig();
+        sp2.position = "6565 15 2635";
+        sp2.radius = 2.0;
+        sp2.tierIds.Insert(1);
+        sp2.tierIds.Insert(2);
+        sp2.entities = 1;
+        sp2.useFixedHeight = false;
+        zone1.spawnPoints.Insert(sp2);
+        
+        ref SpawnPointConfig sp3 = new SpawnPointConfig();
+        sp3.position = "6558 18.5 2628";
+        sp3.radius = 1.0;
+        sp3.tierIds.Insert(2);
+        sp3.entities = 3;
+        sp3.useFixedHeight = true;
+        zone1.spawnPoints.Insert(sp3);
+        
+        container.zones.Insert(zone1);
+        
+        // Zone 2: Underground Bunker Example
+        ref ZoneConfig zone2 = new ZoneConfig();
+        zone2.name = "Test_Zone_Underground_Bunker";
+        zone2.enabled = true;
+        zone2.position = "-1000 -50 -1000";
+        zone2.triggerRadius = 80;
+        zone2.spawnChance = 0.5;
+        zone2.despawnOnExit = true;
+        zone2.despawnDistance = 120;
         zone2.respawnCooldown = 420;
         
-        ref SpawnPointConfig sp4 = new SpawnPointConfig();
-        sp4.position = "-1000 -48.5 -995";
-        sp4.radius = 2.0;
-        sp4.tierIds.Insert(2);
-        sp4.entities = 2;
-        sp4.useFixedHeight = true;
-        zone2.spawnPoints.Insert(sp4);
+        ref SpawnPointConfig sp4 = new SpawnPointConfig();
+        sp4.position = "-1000 -48.5 -995";
+        sp4.radius = 2.0;
+        sp4.tierIds.Insert(2);
+        sp4.entities = 2;
+        sp4.useFixedHeight = true;
+        zone2.spawnPoints.Insert(sp4);
+        
+        ref SpawnPointConfig sp5 = new SpawnPointConfig();
+        sp5.position = "-990 -48.5 -1000";
+        sp5.radius = 1.5;
+        sp5.tierIds.Insert(1);
+        sp5.tierIds.Insert(2);
+        sp5.entities = 3;
+        sp5.useFixedHeight = true;
+        zone2.spawnPoints.Insert(sp5);
+        
+        ref SpawnPointConfig sp6 = new SpawnPointConfig();
+        sp6.position = "-1010 -48.5 -1005";
+        sp6.radius = 2.5;
+        sp6.tierIds.Insert(2);
+        sp6.entities = 1;
+        sp6.useFixedHeight = true;
+        zone2.spawnPoints.Insert(sp6);
+        
+        container.zones.Insert(zone2);
+        
+        JsonFileLoader<ZonesContainer>.JsonSaveFile(filePath, container);
+        SpawnLog().Info("Created default Zones.json with 2 example zones");
+    }
+    
+    // Seconds since 1970-01-01 UTC. Enforce Script only exposes calendar fields, so the day
+    // count is derived from the civil date.
+    static int GetWallClockSeconds()
+    {
+        int year, month, day, hour, minute, second;
+        GetYearMonthDayUTC(year, month, day);
+        GetHourMinuteSecondUTC(hour, minute, second);
+        
+        if (month <= 2)
+            year--;
+        
+        int era = year / 400;
+        int yearOfEra = year - era * 400;
+        int shiftedMonth = month + 9;
+        if (month > 2)
+            shiftedMonth = month - 3;
+        
+        int dayOfYear = (153 * shiftedMonth + 2) / 5 + day - 1;
+        int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        int days = era * 146097 + dayOfEra - 719468;
+        
+        return days * 86400 + hour * 3600 + minute * 60 + second;
+    }
+    
+    void SaveStateSnapshot()
+    {
+        FileSerializer file = new FileSerializer();
+        if (!file.Open(STATE_PATH, FileMode.WRITE))
+        {
+            SpawnLog().Warning("Could not write zone state snapshot");
+            return;
+        }
+        
+        int now = GetWallClockSeconds();
+        
+        file.Write(STATE_VERSION);
+        file.Write(now);
+        file.Write(m_ZoneList.Count());
+        
+        for (int i = 0; i < m_ZoneList.Count(); i++)
+        {
+            SimpleZone zone = m_ZoneList.Get(i);
+            
+            int cooldownExpiry = 0;
+            if (IsCoolingDown(zone))
+                cooldownExpiry = now + Math.Ceil(GetCooldownRemaining(zone));
+            
+            file.Write(zone.name);
+            file.Write(zone.hasSpawned);
+            file.Write(zone.hasRolledChance);
+            file.Write(cooldownExpiry);
+        }
+        
+        file.Close();
+    }
+    
+    void RestoreStateSnapshot()
+    {
+        if (!FileExist(STATE_PATH))
+            return;
+        
+        FileSerializer file = new FileSerializer();
+        if (!file.Open(STATE_PATH, FileMode.READ))
+            return;
+        
+        int version;
+        int savedAt;
+        int zoneCount;
+        if (!file.Read(version) || version != STATE_VERSION || !file.Read(savedAt) || !file.Read(zoneCount))
+        {
+            file.Close();
+            SpawnLog().Info("Zone state snapshot is outdated, starting fresh");
+            return;
+        }
+        
+        int now = GetWallClockSeconds();
+        int restored = 0;
+        
+        for (int i = 0; i < zoneCount; i++)
+        {
+            string name;
+            bool hasSpawned;
+            bool hasRolledChance;
+            int cooldownExpiry;
+            if (!file.Read(name) || !file.Read(hasSpawned) || !file.Read(hasRolledChance) || !file.Read(cooldownExpiry))
+                break;
+            
+            ref SimpleZone zone;
+            if (!m_ZonesMap.Find(name, zone))
+                continue;
+            
+            // A wave that was still alive at shutdown is gone now, so count it as cleared at save time
+            if (cooldownExpiry == 0 && hasSpawned)
+                cooldownExpiry = savedAt + zone.respawnCooldown;
+            
+            if (cooldownExpiry > now)
+            {
+                SetCooldown(zone, cooldownExpiry - now);
+                zone.hasSpawned = hasSpawned;
+                zone.hasRolledChance = hasRolledChance;
+                restored++;
+            }
+        }
+        
+        file.Close();
+        SpawnLog().Info("Restored %1 zone cooldowns from snapshot", restored);
+    }
+    
+    // Loads the configs into staging maps and applies them as a diff against the running zones,
+    // so zones that did not change keep their players, entities and cooldowns
+    void LoadAllConfigs()
+    {
+        SpawnLog().Info("=== LOADING CONFIGURATIONS ===");
+        
+        ref map<int, ref SimpleTier> tiers = new map<int, ref SimpleTier>;
+        ref map<string, ref SimpleZone> zones = new map<string, ref SimpleZone>;
+        
+        int tiersChecksum = ComputeFileChecksum(TIERS_PATH);
+        int zonesChecksum = ComputeFileChecksum(ZONES_PATH);
+        bool fromCache = LoadCompiledCache(tiersChecksum, zonesChecksum, tiers, zones);
+        
+        if (fromCache)
+        {
+            SpawnLog().Info("Loaded compiled cache");
+        }
+        else
+        {
+            LoadTiers(tiers);
+            LoadZones(zones);
+        }
+        
+        m_Tiers = tiers;
+        ApplyZoneDiff(zones);
+        BuildSpatialGrid();
+        
+        if (!fromCache && FileExist(TIERS_PATH) && FileExist(ZONES_PATH))
+        {
+            WriteCompiledCache(tiersChecksum, zonesChecksum);
+        }
+        
+        // The cache keeps the tiers as configured; classnames are checked against the loaded
+        // mods on every start, so a mod added later brings its classes back
+        ValidateTiers(m_Tiers);
+        BuildSpawnTables();
+        
+        // Only the first load after startup; later reloads keep the live state
+        if (!m_StateRestored)
+        {
+            m_StateRestored = true;
+            RestoreStateSnapshot();
+        }
+        
+        SpawnLog().Info("Configuration loaded: %1 tiers, %2 zones", m_Tiers.Count(), m_ZonesMap.Count());
+        SpawnLog().Info("=== SYSTEM READY ===");
+    }
+    
+    void ApplyZoneDiff(map<string, ref SimpleZone> zones)
+    {
+        int added = 0;
+        int changed = 0;
+        int unchanged = 0;
+        int removed = 0;
+        
+        // Zones that are no longer configured
+        array<SimpleZone> removedZones = new array<SimpleZone>;
+        for (int i = 0; i < m_ZonesMap.Count(); i++)
+        {
+            if (!zones.Contains(m_ZonesMap.GetKey(i)))
+                removedZones.Insert(m_ZonesMap.GetElement(i));
+        }
+        
+        for (int r = 0; r < removedZones.Count(); r++)
+        {
+            RetireZone(removedZones.Get(r));
+            removed++;
+        }
+        
+        for (int j = 0; j < zones.Count(); j++)
+        {
+            SimpleZone source = zones.GetElement(j);
+            
+            ref SimpleZone zone;
+            if (!m_ZonesMap.Find(source.name, zone))
+            {
+                m_ZonesMap.Set(source.name, source);
+                RegisterZone(source);
+                added++;
+            }
+            else if (ComputeZoneHash(zone) == ComputeZoneHash(source))
+            {
+                unchanged++;
+            }
+            else
+            {
+                PatchZone(zone, source);
+                changed++;
+            }
+        }
+        
+        // Zones may have moved, appeared or been re-enabled under players that are not moving
+        if (added > 0 || changed > 0 || removed > 0)
+        {
+            for (int p = 0; p < m_PlayerStates.Count(); p++)
+            {
+                m_PlayerStates.GetElement(p).needsRefresh = true;
+            }
+        }
+        
+        SpawnLog().Info("Zone diff: %1 added, %2 changed, %3 unchanged, %4 removed", added, changed, unchanged, removed);
+    }
+    
+    // Copies config fields from source into the running zone, keeping its runtime state
+    void PatchZone(SimpleZone zone, SimpleZone source)
+    {
+        bool geometryChanged = (vector.DistanceSq(zone.position, source.position) > 0.0001 || GetZoneReach(zone) != GetZoneReach(source));
+        
+        zone.enabled = source.enabled;
+        zone.position = source.position;
+        zone.triggerRadius = source.triggerRadius;
+        zone.spawnChance = source.spawnChance;
+        zone.despawnOnExit = source.despawnOnExit;
+        zone.despawnDistance = source.despawnDistance;
+        zone.respawnCooldown = source.respawnCooldown;
+        zone.exitRadius = source.exitRadius;
+        zone.armingDelay = source.armingDelay;
+        zone.despawnGrace = source.despawnGrace;
+        
+        // Spawn points are matched by position in the list; tracked entities stay on patched points
+        for (int i = 0; i < source.spawnPoints.Count(); i++)
+        {
+            SimpleSpawnPoint sourcePoint = source.spawnPoints.Get(i);
+            
+            if (i >= zone.spawnPoints.Count())
+            {
+                zone.spawnPoints.Insert(sourcePoint);
+                continue;
+            }
+            
+            SimpleSpawnPoint point = zone.spawnPoints.Get(i);
+            if (ComputePointHash(point) != ComputePointHash(sourcePoint))
+            {
+                point.position = sourcePoint.position;
+                point.radius = sourcePoint.radius;
+                point.entities = sourcePoint.entities;
+                point.useFixedHeight = sourcePoint.useFixedHeight;
+                point.tierIds.Copy(sourcePoint.tierIds);
+                point.tierWeights.Copy(sourcePoint.tierWeights);
+                
+                // Candidates are rebuilt for the new geometry on the next spawn
+                point.candidatesBuilt = false;
+                for (int e = 0; e < point.spawnedEntities.Count(); e++)
+                {
+                    point.spawnedEntities.Get(e).candidate = -1;
+                }
+            }
+        }
+        
+        if (zone.spawnPoints.Count() > source.spawnPoints.Count())
+        {
+            // Queued jobs of the removed points would never finish the wave
+            CancelPendingSpawns(zone);
+            
+            for (int j = zone.spawnPoints.Count() - 1; j >= source.spawnPoints.Count(); j--)
+            {
+                zone.virtualCount -= zone.spawnPoints.Get(j).virtualCreatures.Count();
+                RetirePointEntities(zone.spawnPoints.Get(j));
+                zone.spawnPoints.RemoveOrdered(j);
+            }
+            
+            if (zone.liveEntities == 0)
+                ResetZoneSpawnState(zone);
+        }
+        
+        if (!zone.enabled)
+        {
+            CancelPendingSpawns(zone);
+            ClearVirtualPopulation(zone);
+            for (int k = 0; k < zone.spawnPoints.Count(); k++)
+            {
+                RetirePointEntities(zone.spawnPoints.Get(k));
+            }
+            ForgetZoneMembership(zone);
+            ResetZoneSpawnState(zone);
+        }
+        
+        if (geometryChanged)
+        {
+            m_ZoneIndex.Remove(zone);
+        }
+        
+        SyncZoneFields(zone);
+        
+        SpawnLog().Debug("Patched zone: %1", zone.name);
+    }
+    
+    void RetireZone(SimpleZone zone)
+    {
+        CancelPendingSpawns(zone);
+        
+        for (int i = 0; i < zone.spawnPoints.Count(); i++)
+        {
+            RetirePointEntities(zone.spawnPoints.Get(i));
+        }
+        ResetZoneSpawnState(zone);
+        
+        m_ZoneIndex.Remove(zone);
+        ForgetZoneMembership(zone);
+        UnregisterZone(zone);
+        m_ZonesMap.Remove(zone.name);
+        
+        SpawnLog().Debug("Removed zone: %1", zone.name);
+    }
+    
+    // For zones whose creatures were taken away by a reload rather than killed: no cooldown,
+    // the next entry spawns a fresh wave
+    void ResetZoneSpawnState(SimpleZone zone)
+    {
+        zone.hasSpawned = false;
+        zone.hasRolledChance = false;
+        zone.armedSince = -1;
+        zone.emptySince = -1;
+    }
+    
+    void RegisterZone(SimpleZone zone)
+    {
+        zone.id = m_ZoneList.Count();
+        m_ZoneList.Insert(zone);
+        m_ZoneX.Insert(0);
+        m_ZoneY.Insert(0);
+        m_ZoneZ.Insert(0);
+        m_ZoneTriggerSq.Insert(0);
+        m_ZoneExitSq.Insert(0);
+        m_ZoneDespawnSq.Insert(0);
+        m_ZoneReach.Insert(0);
+        m_ZoneReachSq.Insert(0);
+        m_ZoneBorderInnerSq.Insert(0);
+        m_ZoneBorderOuterSq.Insert(0);
+        m_ZoneEnabled.Insert(false);
+        SyncZoneFields(zone);
+    }
+    
+    void SyncZoneFields(SimpleZone zone)
+    {
+        int id = zone.id;
+        float reach = GetZoneReach(zone);
+        
+        m_ZoneX.Set(id, zone.position[0]);
+        m_ZoneY.Set(id, zone.position[1]);
+        m_ZoneZ.Set(id, zone.position[2]);
+        m_ZoneTriggerSq.Set(id, zone.triggerRadius * zone.triggerRadius);
+        m_ZoneExitSq.Set(id, zone.exitRadius * zone.exitRadius);
+        m_ZoneDespawnSq.Set(id, zone.despawnDistance * zone.despawnDistance);
+        m_ZoneReach.Set(id, reach);
+        m_ZoneReachSq.Set(id, reach * reach);
+        
+        float borderInner = Math.Max(zone.triggerRadius - BORDER_MARGIN, 0);
+        float borderOuter = zone.triggerRadius + BORDER_MARGIN;
+        m_ZoneBorderInnerSq.Set(id, borderInner * borderInner);
+        m_ZoneBorderOuterSq.Set(id, borderOuter * borderOuter);
+        m_ZoneEnabled.Set(id, zone.enabled);
+    }
+    
+    // array.Remove moves the last element into the hole, so ids stay dense
+    void UnregisterZone(SimpleZone zone)
+    {
+        int id = zone.id;
+        if (id < 0)
+            return;
+        
+        m_ZoneList.Remove(id);
+        m_ZoneX.Remove(id);
+        m_ZoneY.Remove(id);
+        m_ZoneZ.Remove(id);
+        m_ZoneTriggerSq.Remove(id);
+        m_ZoneExitSq.Remove(id);
+        m_ZoneDespawnSq.Remove(id);
+        m_ZoneReach.Remove(id);
+        m_ZoneReachSq.Remove(id);
+        m_ZoneBorderInnerSq.Remove(id);
+        m_ZoneBorderOuterSq.Remove(id);
+        m_ZoneEnabled.Remove(id);
+        
+        if (id < m_ZoneList.Count())
+        {
+            m_ZoneList.Get(id).id = id;
+        }
+        zone.id = -1;
+    }
+    
+    // Untracks the point's entities and hands them to the despawn queue. Returns how many were queued.
+    int RetirePointEntities(SimpleSpawnPoint point)
+    {
+        int queued = 0;
+        float priority = GetDespawnPriority(point.position);
+        
+        for (int i = 0; i < point.spawnedEntities.Count(); i++)
+        {
+            SimpleSpawnedEntity record = point.spawnedEntities.Get(i);
+            UntrackEntity(record);
+            
+            if (record.entity)
+            {
+                QueueDespawn(record.entity, record.zone, priority);
+                queued++;
+            }
+        }
+        point.spawnedEntities.Clear();
+        
+        return queued;
+    }
+    
+    // One lookup per spawn point; players beyond the search radius all count as equally far
+    float GetDespawnPriority(vector pos)
+    {
+        float closest = m_PlayerGrid.ClosestDistanceSq(pos, DESPAWN_PRIORITY_RADIUS);
+        if (closest < 0)
+            return -999999.0 * 999999.0;
+        
+        return -closest;
+    }
+    
+    void QueueDespawn(EntityAI entity, SimpleZone zone, float priority)
+    {
+        SimpleDespawnJob job = new SimpleDespawnJob();
+        job.entity = entity;
+        job.zone = zone;
+        job.priority = priority;
+        m_DespawnQueue.Push(job);
+        
+        if (zone)
+            zone.queuedDespawns++;
+        
+        StartDespawnPump();
+    }
+    
+    void StartDespawnPump()
+    {
+        if (m_DespawnPumpActive)
+            return;
+        
+        m_DespawnPumpActive = true;
+        m_World.GetCallQueue().CallLater(ProcessDespawnQueue, DESPAWN_QUEUE_TICK_MS, true);
+    }
+    
+    void StopDespawnPump()
+    {
+        if (!m_DespawnPumpActive)
+            return;
+        
+        m_DespawnPumpActive = false;
+        m_World.GetCallQueue().Remove(ProcessDespawnQueue);
+    }
+    
+    // Drains queued despawns within the per-tick entity and time budget
+    void ProcessDespawnQueue()
+    {
+        int startTicks = TickCount(0);
+        int released = 0;
+        
+        while (m_DespawnQueue.Count() > 0)
+        {
+            if (m_GlobalSettings.despawnsPerTick > 0 && released >= m_GlobalSettings.despawnsPerTick)
+                break;
+            
+            if (m_GlobalSettings.despawnBudgetMs > 0 && released > 0 && TickCount(startTicks) / 10000.0 >= m_GlobalSettings.despawnBudgetMs)
+                break;
+            
+            SimpleDespawnJob job = SimpleDespawnJob.Cast(m_DespawnQueue.Pop());
+            if (job.zone)
+                job.zone.queuedDespawns--;
+            
+            // Deleted by something else while queued
+            if (!job.entity)
+                continue;
+            
+            ReleaseEntity(job.entity);
+            released++;
+        }
+        
+        if (m_DespawnQueue.Count() == 0)
+        {
+            StopDespawnPump();
+        }
+        
+        m_Metrics.Record(SimpleMetrics.PHASE_DESPAWN_QUEUE, startTicks);
+        m_Metrics.AddWork(SimpleMetrics.PHASE_DESPAWN_QUEUE, 0, 0, released);
+    }
+    
+    // Releases the zone's queued entities at once, so it can spawn again right away. Pops the
+    // whole heap, meant for debug commands only.
+    void FlushZoneDespawns(SimpleZone zone)
+    {
+        if (zone.queuedDespawns == 0)
+            return;
+        
+        array<ref SimpleHeapItem> kept = new array<ref SimpleHeapItem>;
+        while (m_DespawnQueue.Count() > 0)
+        {
+            SimpleDespawnJob job = SimpleDespawnJob.Cast(m_DespawnQueue.Pop());
+            if (job.zone != zone)
+            {
+                kept.Insert(job);
+                continue;
+            }
+            
+            zone.queuedDespawns--;
+            if (job.entity)
+            {
+                ReleaseEntity(job.entity);
+            }
+        }
+        
+        for (int i = 0; i < kept.Count(); i++)
+        {
+            m_DespawnQueue.Push(kept.Get(i));
+        }
+        
+        if (m_DespawnQueue.Count() == 0)
+        {
+            StopDespawnPump();
+        }
+    }
+    
+    // Releases everything still queued at once, for teardown
+    void FlushDespawnQueue()
+    {
+        while (m_DespawnQueue.Count() > 0)
+        {
+            SimpleDespawnJob job = SimpleDespawnJob.Cast(m_DespawnQueue.Pop());
+            if (job.zone)
+                job.zone.queuedDespawns--;
+            
+            if (job.entity)
+            {
+                ReleaseEntity(job.entity);
+            }
+        }
+        
+        StopDespawnPump();
+    }
+    
+    void ForgetZoneMembership(SimpleZone zone)
+    {
+        for (int i = 0; i < zone.nearbyPlayers.Count(); i++)
+        {
+            zone.nearbyPlayers.Get(i).zones.RemoveItem(zone);
+        }
+        
+        zone.nearbyPlayers.Clear();
+        zone.playersInside.Clear();
+        m_ActiveZones.RemoveItem(zone);
+    }
+    
+    int ComputePointHash(SimpleSpawnPoint point)
+    {
+        string data = point.position.ToString() + "|" + point.radius.ToString() + "|" + point.entities.ToString() + "|" + point.useFixedHeight.ToString();
+        for (int i = 0; i < point.tierIds.Count(); i++)
+        {
+            data += "|" + point.tierIds.Get(i).ToString();
+        }
+        for (int j = 0; j < point.tierWeights.Count(); j++)
+        {
+            data += "|w" + point.tierWeights.Get(j).ToString();
+        }
+        return data.Hash();
+    }
+    
+    int ComputeZoneHash(SimpleZone zone)
+    {
+        string data = zone.name + "|" + zone.enabled.ToString() + "|" + zone.position.ToString() + "|" + zone.triggerRadius.ToString();
+        data += "|" + zone.spawnChance.ToString() + "|" + zone.despawnOnExit.ToString() + "|" + zone.despawnDistance.ToString() + "|" + zone.respawnCooldown.ToString();
+        data += "|" + zone.exitRadius.ToString() + "|" + zone.armingDelay.ToString() + "|" + zone.despawnGrace.ToString();
+        
+        for (int i = 0; i < zone.spawnPoints.Count(); i++)
+        {
+            data += "|" + ComputePointHash(zone.spawnPoints.Get(i)).ToString();
+        }
+        return data.Hash();
+    }
+    
+    void LoadTiers(map<int, ref SimpleTier> tiers)
+    {
+        string tiersPath = TIERS_PATH;
+        
+        if (!FileExist(tiersPath))
+        {
+            SpawnLog().Error("Tiers.json not found!");
+            return;
+        }
+        
+        ref TiersContainer container = new TiersContainer();
+        JsonFileLoader<TiersContainer>.JsonLoadFile(tiersPath, container);
+        
+        if (container && container.tiers && container.tiers.Count() > 0)
+        {
+            for (int i = 0; i < container.tiers.Count(); i++)
+            {
+                int tierId = container.tiers.GetKey(i);
+                ref TierConfig config = container.tiers.GetElement(i);
+                
+                if (config)
+                {
+                    ref SimpleTier tier = new SimpleTier();
+                    tier.name = config.name;
+                    
+                    for (int j = 0; j < config.classnames.Count(); j++)
+                    {
+                        tier.classnames.Insert(config.classnames.Get(j));
+                    }
+                    
+                    if (config.weights && config.weights.Count() > 0)
+                    {
+                        if (config.weights.Count() == config.classnames.Count())
+                            tier.weights.Copy(config.weights);
+                        else
+                            SpawnLog().Warning("Tier %1 has %2 weights for %3 classnames, using equal odds", tierId, config.weights.Count(), config.classnames.Count());
+                    }
+                    
+                    tiers.Set(tierId, tier);
+                    SpawnLog().Debug("Loaded tier %1: %2", tierId, tier.name);
+                }
+            }
+        }
+    }
+    
+    void LoadZones(map<string, ref SimpleZone> zones)
+    {
+        string zonesPath = ZONES_PATH;
+        
+        if (!FileExist(zonesPath))
+        {
+            SpawnLog().Error("Zones.json not found!");
+            return;
+        }
+        
+        ref ZonesContainer container = new ZonesContainer();
+        JsonFileLoader<ZonesContainer>.JsonLoadFile(zonesPath, container);
+        
+        if (container)
+        {
+            if (container.globalSettings)
+            {
+                ApplyGlobalSettings(container.globalSettings);
+                SpawnLog().Info("Loaded global settings");
+            }
+            
+            if (container.zones && container.zones.Count() > 0)
+            {
+                for (int i = 0; i < container.zones.Count(); i++)
+                {
+                    ref ZoneConfig config = container.zones.Get(i);
+                    if (config)
+                    {
+                        ref SimpleZone zone = new SimpleZone();
+                        zone.name = config.name;
+                        zone.enabled = config.enabled;
+                        zone.position = config.position.ToVector();
+                        zone.triggerRadius = config.triggerRadius;
+                        zone.spawnChance = config.spawnChance;
+                        zone.despawnOnExit = config.despawnOnExit;
+                        zone.despawnDistance = config.despawnDistance;
+                        zone.respawnCooldown = config.respawnCooldown;
+                        zone.exitRadius = Math.Max(config.exitRadius, config.triggerRadius);
+                        zone.armingDelay = config.armingDelay;
+                        zone.despawnGrace = config.despawnGrace;
+                        
+                        int totalEntities = 0;
+                        
+                        for (int j = 0; j < config.spawnPoints.Count(); j++)
+                        {
+                            ref SpawnPointConfig spConfig = config.spawnPoints.Get(j);
+                            if (spConfig)
+                            {
+                                ref SimpleSpawnPoint sp = new SimpleSpawnPoint();
+                                sp.position = spConfig.position.ToVector();
+                                sp.radius = spConfig.radius;
+                                sp.entities = spConfig.entities;
+                                sp.useFixedHeight = spConfig.useFixedHeight;
+                                totalEntities += spConfig.entities;
+                                
+                                for (int k = 0; k < spConfig.tierIds.Count(); k++)
+                                {
+                                    sp.tierIds.Insert(spConfig.tierIds.Get(k));
+                                }
+                                
+                                if (spConfig.tierWeights && spConfig.tierWeights.Count() > 0)
+                                {
+                                    if (spConfig.tierWeights.Count() == spConfig.tierIds.Count())
+                                        sp.tierWeights.Copy(spConfig.tierWeights);
+                                    else
+                                        SpawnLog().Warning("Spawn point %1 of zone %2 has mismatched tierWeights, using equal odds", j, zone.name);
+                                }
+                                
+                                zone.spawnPoints.Insert(sp);
+                            }
+                        }
+                        
+                        zones.Set(zone.name, zone);
+                        
+                        SpawnLog().Debug("Loaded zone: %1 (spawn chance %2 percent, %3 spawn points, %4 entities)", zone.name, zone.spawnChance * 100, zone.spawnPoints.Count(), totalEntities);
+                    }
+                }
+            }
+        }
+    }
+    
+    void ApplyGlobalSettings(GlobalSettingsConfig settings)
+    {
+        m_GlobalSettings = settings;
+        m_SystemEnabled = m_GlobalSettings.systemEnabled;
+        
+        // The logger is shared, a benchmark must not change the live server's level
+        if (!m_IsSimulation)
+            SpawnLog().SetLevel(m_GlobalSettings.logLevel);
+        
+        m_CheckInterval = m_GlobalSettings.checkInterval;
+        m_MinSpawnDistanceFromPlayer = m_GlobalSettings.minSpawnDistanceFromPlayer;
+        
+        if (m_GlobalSettings.entityPoolEnabled)
+        {
+            m_EntityPool.SetCapacity(m_GlobalSettings.entityPoolSize);
+        }
+        else
+        {
+            m_EntityPool.SetCapacity(0);
+        }
+    }
+    
+    // Enforce Script exposes no file timestamps, so the cache is keyed on a hash of the JSON text.
+    // Hashing lines is far cheaper than parsing and converting the whole document.
+    int ComputeFileChecksum(string path)
+    {
+        if (!FileExist(path))
+            return 0;
+        
+        FileHandle file = OpenFile(path, FileMode.READ);
+        if (file == 0)
+            return 0;
+        
+        int checksum = 17;
+        string line;
+        while (FGets(file, line) >= 0)
+        {
+            checksum = (checksum * 31) + line.Hash();
+        }
+        
+        CloseFile(file);
+        return checksum;
+    }
+    
+    void WriteCompiledCache(int tiersChecksum, int zonesChecksum)
+    {
+        FileSerializer file = new FileSerializer();
+        if (!file.Open(CACHE_PATH, FileMode.WRITE))
+        {
+            SpawnLog().Warning("Could not write compiled cache");
+            return;
+        }
+        
+        // Settings go in as JSON so new fields never require a layout change
+        string settingsJson;
+        JsonSerializer json = new JsonSerializer();
+        json.WriteToString(m_GlobalSettings, false, settingsJson);
+        
+        file.Write(CACHE_VERSION);
+        file.Write(tiersChecksum);
+        file.Write(zonesChecksum);
+        file.Write(settingsJson);
+        
+        file.Write(m_Tiers.Count());
+        for (int i = 0; i < m_Tiers.Count(); i++)
+        {
+            file.Write(m_Tiers.GetKey(i));
+            WriteCachedTier(file, m_Tiers.GetElement(i));
+        }
+        
+        file.Write(m_ZoneList.Count());
+        for (int j = 0; j < m_ZoneList.Count(); j++)
+        {
+            WriteCachedZone(file, m_ZoneList.Get(j));
+        }
+        
+        file.Close();
+        SpawnLog().Info("Wrote compiled cache");
+    }
+    
+    void WriteCachedTier(FileSerializer file, SimpleTier tier)
+    {
+        file.Write(tier.name);
+        file.Write(tier.classnames.Count());
+        for (int i = 0; i < tier.classnames.Count(); i++)
+        {
+            file.Write(tier.classnames.Get(i));
+        }
+        
+        WriteCachedFloats(file, tier.weights);
+    }
+    
+    void WriteCachedFloats(FileSerializer file, array<float> values)
+    {
+        file.Write(values.Count());
+        for (int i = 0; i < values.Count(); i++)
+        {
+            file.Write(values.Get(i));
+        }
+    }
+    
+    bool ReadCachedFloats(FileSerializer file, array<float> values)
+    {
+        int count;
+        if (!file.Read(count))
+            return false;
+        
+        for (int i = 0; i < count; i++)
+        {
+            float value;
+            if (!file.Read(value))
+                return false;
+            
+            values.Insert(value);
+        }
+        return true;
+    }
+    
+    void WriteCachedZone(FileSerializer file, SimpleZone zone)
+    {
+        file.Write(zone.name);
+        file.Write(zone.enabled);
+        file.Write(zone.position);
+        file.Write(zone.triggerRadius);
+        file.Write(zone.spawnChance);
+        file.Write(zone.despawnOnExit);
+        file.Write(zone.despawnDistance);
+        file.Write(zone.respawnCooldown);
+        file.Write(zone.exitRadius);
+        file.Write(zone.armingDelay);
+        file.Write(zone.despawnGrace);
+        
+        file.Write(zone.spawnPoints.Count());
+        for (int i = 0; i < zone.spawnPoints.Count(); i++)
+        {
+            SimpleSpawnPoint point = zone.spawnPoints.Get(i);
+            file.Write(point.position);
+            file.Write(point.radius);
+            file.Write(point.entities);
+            file.Write(point.useFixedHeight);
+            
+            file.Write(point.tierIds.Count());
+            for (int j = 0; j < point.tierIds.Count(); j++)
+            {
+                file.Write(point.tierIds.Get(j));
+            }
+            
+            WriteCachedFloats(file, point.tierWeights);
+        }
+        
+        file.Write(zone.indexRadius);
+        file.Write(zone.indexCells.Count());
+        for (int k = 0; k < zone.indexCells.Count(); k++)
+        {
+            file.Write(zone.indexCells.Get(k));
+        }
+    }
+    
+    // Returns false and leaves no partial state behind if the cache is missing, stale or unreadable
+    bool LoadCompiledCache(int tiersChecksum, int zonesChecksum, map<int, ref SimpleTier> tiers, map<string, ref SimpleZone> zones)
+    {
+        if (tiersChecksum == 0 || zonesChecksum == 0 || !FileExist(CACHE_PATH))
+            return false;
+        
+        FileSerializer file = new FileSerializer();
+        if (!file.Open(CACHE_PATH, FileMode.READ))
+            return false;
+        
+        bool loaded = ReadCompiledCache(file, tiersChecksum, zonesChecksum, tiers, zones);
+        file.Close();
+        
+        if (!loaded)
+        {
+            tiers.Clear();
+            zones.Clear();
+        }
+        
+        return loaded;
+    }
+    
+    bool ReadCompiledCache(FileSerializer file, int tiersChecksum, int zonesChecksum, map<int, ref SimpleTier> tiers, map<string, ref SimpleZone> zones)
+    {
+        int version;
+        int cachedTiersChecksum;
+        int cachedZonesChecksum;
+        string settingsJson;
+        
+        if (!file.Read(version) || version != CACHE_VERSION)
+            return false;
+        if (!file.Read(cachedTiersChecksum) || cachedTiersChecksum != tiersChecksum)
+            return false;
+        if (!file.Read(cachedZonesChecksum) || cachedZonesChecksum != zonesChecksum)
+            return false;
+        if (!file.Read(settingsJson))
+            return false;
+        
+        GlobalSettingsConfig settings = new GlobalSettingsConfig();
+        JsonSerializer json = new JsonSerializer();
+        string error;
+        if (!json.ReadFromString(settings, settingsJson, error))
+            return false;
+        
+        int tierCount;
+        if (!file.Read(tierCount))
+            return false;
+        
+        for (int i = 0; i < tierCount; i++)
+        {
+            int tierId;
+            if (!file.Read(tierId))
+                return false;
+            
+            SimpleTier tier = ReadCachedTier(file);
+            if (!tier)
+                return false;
+            
+            tiers.Set(tierId, tier);
+        }
+        
+        int zoneCount;
+        if (!file.Read(zoneCount))
+            return false;
+        
+        for (int j = 0; j < zoneCount; j++)
+        {
+            SimpleZone zone = ReadCachedZone(file);
+            if (!zone)
+                return false;
+            
+            zones.Set(zone.name, zone);
+        }
+        
+        ApplyGlobalSettings(settings);
+        return true;
+    }
+    
+    SimpleTier ReadCachedTier(FileSerializer file)
+    {
+        SimpleTier tier = new SimpleTier();
+        int classCount;
+        
+        if (!file.Read(tier.name) || !file.Read(classCount))
+            return null;
+        
+        for (int i = 0; i < classCount; i++)
+        {
+            string classname;
+            if (!file.Read(classname))
+                return null;
+            
+            tier.classnames.Insert(classname);
+        }
+        
+        if (!ReadCachedFloats(file, tier.weights))
+            return null;
+        
+        return tier;
+    }
+    
+    // Restores a zone in runtime form along with its precomputed index cells
+    SimpleZone ReadCachedZone(FileSerializer file)
+    {
+        SimpleZone zone = new SimpleZone();
+        int pointCount;
+        
+        if (!file.Read(zone.name) || !file.Read(zone.enabled) || !file.Read(zone.position))
+            return null;
+        if (!file.Read(zone.triggerRadius) || !file.Read(zone.spawnChance) || !file.Read(zone.despawnOnExit))
+            return null;
+        if (!file.Read(zone.despawnDistance) || !file.Read(zone.respawnCooldown))
+            return null;
+        if (!file.Read(zone.exitRadius) || !file.Read(zone.armingDelay) || !file.Read(zone.despawnGrace) || !file.Read(pointCount))
+            return null;
+        
+        for (int i = 0; i < pointCount; i++)
+        {
+            SimpleSpawnPoint point = new SimpleSpawnPoint();
+            int tierCount;
+            
+            if (!file.Read(point.position) || !file.Read(point.radius) || !file.Read(point.entities))
+                return null;
+            if (!file.Read(point.useFixedHeight) || !file.Read(tierCount))
+                return null;
+            
+            for (int j = 0; j < tierCount; j++)
+            {
+                int tierId;
+                if (!file.Read(tierId))
+                    return null;
+                
+                point.tierIds.Insert(tierId);
+            }
+            
+            if (!ReadCachedFloats(file, point.tierWeights))
+                return null;
+            
+            zone.spawnPoints.Insert(point);
+        }
+        
+        int cellCount;
+        if (!file.Read(zone.indexRadius) || !file.Read(cellCount))
+            return null;
+        
+        for (int k = 0; k < cellCount; k++)
+        {
+            int cell;
+            if (!file.Read(cell))
+                return null;
+            
+            zone.indexCells.Insert(cell);
+        }
+        
+        return zone;
+    }
+    
+    int GetSpawnableKind(string classname)
+    {
+        int kind;
+        if (!m_SpawnableKinds.Find(classname, kind))
+        {
+            kind = m_World.ClassifySpawnable(classname);
+            m_SpawnableKinds.Set(classname, kind);
+        }
+        return kind;
+    }
+    
+    // Drops classnames that do not exist so spawning never attempts them, and reports the
+    // result once for the whole load
+    void ValidateTiers(map<int, ref SimpleTier> tiers)
+    {
+        int creatures = 0;
+        int animals = 0;
+        string invalidNames = "";
+        int invalidCount = 0;
+        string otherNames = "";
+        
+        for (int i = 0; i < tiers.Count(); i++)
+        {
+            int tierId = tiers.GetKey(i);
+            SimpleTier tier = tiers.GetElement(i);
+            bool weighted = (tier.weights.Count() == tier.classnames.Count());
+            
+            for (int j = tier.classnames.Count() - 1; j >= 0; j--)
+            {
+                string classname = tier.classnames.Get(j);
+                int kind = GetSpawnableKind(classname);
+                
+                if (kind == SimpleSpawnWorld.KIND_CREATURE)
+                {
+                    creatures++;
+                }
+                else if (kind == SimpleSpawnWorld.KIND_ANIMAL)
+                {
+                    animals++;
+                }
+                else if (kind == SimpleSpawnWorld.KIND_OTHER)
+                {
+                    otherNames += " " + classname;
+                }
+                else
+                {
+                    invalidNames += " " + classname + "(tier " + tierId.ToString() + ")";
+                    invalidCount++;
+                    
+                    tier.classnames.RemoveOrdered(j);
+                    if (weighted)
+                        tier.weights.RemoveOrdered(j);
+                }
+            }
+            
+            if (tier.classnames.Count() == 0)
+            {
+                SpawnLog().Warning("Tier %1 (%2) has no spawnable classnames", tierId, tier.name);
+            }
+        }
+        
+        if (invalidCount > 0)
+        {
+            SpawnLog().Warning("Dropped %1 unknown classnames:%2", invalidCount, invalidNames);
+        }
+        
+        if (otherNames != "")
+        {
+            SpawnLog().Warning("Classnames that are neither infected nor animals:%1", otherNames);
+        }
+        
+        SpawnLog().Info("Validated classnames: %1 infected, %2 animals", creatures, animals);
+    }
+    
+    // Builds the weighted sampling tables and points every spawn point at its tier objects.
+    // Tiers are replaced on each load, so this runs for all zones, not just changed ones.
+    void BuildSpawnTables()
+    {
+        for (int t = 0; t < m_Tiers.Count(); t++)
+        {
+            SimpleTier tier = m_Tiers.GetElement(t);
+            tier.classTable.Build(tier.classnames.Count(), tier.weights);
+        }
+        
+        for (int i = 0; i < m_ZoneList.Count(); i++)
+        {
+            SimpleZone zone = m_ZoneList.Get(i);
+            for (int j = 0; j < zone.spawnPoints.Count(); j++)
+            {
+                BuildPointTable(zone, zone.spawnPoints.Get(j));
+            }
+        }
+    }
+    
+    void BuildPointTable(SimpleZone zone, SimpleSpawnPoint point)
+    {
+        point.tiers.Clear();
+        
+        bool weighted = (point.tierWeights.Count() == point.tierIds.Count());
+        array<float> weights = new array<float>;
+        
+        for (int i = 0; i < point.tierIds.Count(); i++)
+        {
+            SimpleTier tier;
+            if (!m_Tiers.Find(point.tierIds.Get(i), tier) || !tier || tier.classnames.Count() == 0)
+            {
+                SpawnLog().Warning("Zone %1 references missing or empty tier %2", zone.name, point.tierIds.Get(i));
+                continue;
+            }
+            
+            point.tiers.Insert(tier);
+            if (weighted)
+                weights.Insert(point.tierWeights.Get(i));
+        }
+        
+        point.tierTable.Build(point.tiers.Count(), weights);
+        
+        if (point.tiers.Count() == 0 && point.tierIds.Count() > 0)
+        {
+            SpawnLog().Warning("A spawn point of zone %1 has nothing spawnable and is skipped", zone.name);
+        }
+    }
+    
+    // Indexes zones that are new or whose geometry changed; everything else keeps its cells
+    void BuildSpatialGrid()
+    {
+        int indexed = 0;
+        
+        for (int i = 0; i < m_ZoneList.Count(); i++)
+        {
+            SimpleZone zone = m_ZoneList.Get(i);
+            if (zone.isIndexed)
+                continue;
+            
+            float reach = m_ZoneReach.Get(i);
+            
+            // Cells precomputed by the compiled cache are only valid for the same reach
+            if (zone.indexCells.Count() > 0 && zone.indexRadius == reach)
+            {
+                m_ZoneIndex.InsertCells(zone, reach, zone.indexCells);
+            }
+            else
+            {
+                m_ZoneIndex.Insert(zone, Vector(m_ZoneX.Get(i), 0, m_ZoneZ.Get(i)), reach);
+            }
+            
+            indexed++;
+        }
+        
+        SpawnLog().Info("Indexed %1 zones, spatial index has %2 cells on %3 levels", indexed, m_ZoneIndex.GetCellCount(), m_ZoneIndex.GetLevelCount());
+    }
+    
+    void Update(float timeslice)
+    {
+        // Lifetimes keep running while the system is toggled off, like the old CallLater timers
+        m_LifetimeWheel.Advance(timeslice, m_ExpiredEntities);
+        for (int e = 0; e < m_ExpiredEntities.Count(); e++)
+        {
+            OnEntityLifetimeExpired(m_ExpiredEntities.Get(e));
+        }
+        m_ExpiredEntities.Clear();
+        
+        SpawnLog().Update(timeslice);
+        
+        if (!m_SystemEnabled) return;
+        
+        m_Time += timeslice;
+        m_CheckTimer += timeslice;
+        m_MaxTimeslice = Math.Max(m_MaxTimeslice, timeslice);
+        
+        if (m_GlobalSettings.metricsFlushInterval > 0)
+        {
+            m_MetricsTimer += timeslice;
+            if (m_MetricsTimer >= m_GlobalSettings.metricsFlushInterval)
+            {
+                m_Metrics.Flush(GetWallClockSeconds(), m_MetricsTimer);
+                m_MetricsTimer = 0;
+            }
+        }
+        
+        if (m_GlobalSettings.stateSnapshotInterval > 0 && m_StateRestored)
+        {
+            m_SnapshotTimer += timeslice;
+            if (m_SnapshotTimer >= m_GlobalSettings.stateSnapshotInterval)
+            {
+                m_SnapshotTimer = 0;
+                SaveStateSnapshot();
+            }
+        }
+        
+        // End zone cooldowns that are due
+        while (m_Cooldowns.Count() > 0 && m_Cooldowns.Peek().priority <= m_Time)
+        {
+            SimpleCooldownEntry entry = SimpleCooldownEntry.Cast(m_Cooldowns.Pop());
+            SimpleZone zone = entry.zone;
+            
+            // Zone was reloaded, or its cooldown was cleared or restarted since
+            if (!zone || zone.cooldownExpiry != entry.priority)
+                continue;
+            
+            zone.cooldownExpiry = 0;
+            zone.hasSpawned = false;
+            zone.hasRolledChance = false;
+        }
+        
+        // Check zones
+        if (m_CheckTimer >= m_CheckInterval)
+        {
+            m_CheckTimer = 0.0;
+            
+            int startTicks = TickCount(0);
+            CheckPlayersOptimized();
+            float checkMs = TickCount(startTicks) / 10000.0;
+            m_Metrics.RecordMs(SimpleMetrics.PHASE_CHECK_PLAYERS, checkMs);
+            
+            // Time-sliced zone work of the previous cycle ran between checks, count it here
+            m_LastCheckMs = checkMs + m_ZoneWorkMs;
+            m_ZoneWorkMs = 0;
+            
+            AdaptCheckInterval();
+        }
+    }
+    
+    // Shortens the interval while players are near zone borders or moving fast, lengthens it
+    // when nobody is near any zone or when checks or server ticks run over budget
+    void AdaptCheckInterval()
+    {
+        float configured = m_GlobalSettings.checkInterval;
+        
+        if (!m_GlobalSettings.adaptiveCheckInterval)
+        {
+            m_CheckInterval = configured;
+        }
+        else
+        {
+            float minInterval = m_GlobalSettings.minCheckInterval;
+            float maxInterval = Math.Max(m_GlobalSettings.maxCheckInterval, minInterval);
+            
+            bool overBudget = (m_LastCheckMs > m_GlobalSettings.checkBudgetMs);
+            bool serverHitching = (m_MaxTimeslice > (UPDATE_INTERVAL_MS / 1000.0) * 1.5);
+            bool busy = (m_PlayersNearBorder > 0 || m_FastPlayers > 0);
+            bool idle = (m_PlayersOnline == 0 || (m_ActiveZones.Count() == 0 && m_ZoneWorkList.Count() == 0));
+            
+            float target = configured;
+            if (overBudget || serverHitching)
+                target = m_CheckInterval * 2.0;
+            else if (busy)
+                target = minInterval;
+            else if (idle)
+                target = maxInterval;
+            
+            // React to pressure at once, relax gradually
+            if (target < m_CheckInterval)
+                m_CheckInterval = target;
+            else
+                m_CheckInterval += (target - m_CheckInterval) * 0.5;
+            
+            m_CheckInterval = Math.Clamp(m_CheckInterval, minInterval, maxInterval);
+        }
+        
+        m_MaxTimeslice = 0;
+        m_PlayersNearBorder = 0;
+    }
+    
+    // Players closer than this to the zone center are tracked as nearby. The move threshold is
+    // added so a player who has not been re-queried cannot reach the trigger or despawn radius unseen.
+    float GetZoneReach(SimpleZone zone)
+    {
+        return Math.Max(Math.Max(zone.triggerRadius, zone.exitRadius), zone.despawnDistance) + PLAYER_MOVE_THRESHOLD;
+    }
+    
+    bool IsWithinReach(SimpleZone zone, vector pos)
+    {
+        int id = zone.id;
+        float dx = pos[0] - m_ZoneX.Get(id);
+        float dz = pos[2] - m_ZoneZ.Get(id);
+        return (dx * dx) + (dz * dz) <= m_ZoneReachSq.Get(id);
+    }
+    
+    void MarkZoneDirty(SimpleZone zone, array<SimpleZone> dirtyZones)
+    {
+        if (zone.lastCheckEpoch == m_CheckEpoch)
+            return;
+        
+        zone.lastCheckEpoch = m_CheckEpoch;
+        dirtyZones.Insert(zone);
+    }
+    
+    void StartCooldown(SimpleZone zone)
+    {
+        SetCooldown(zone, zone.respawnCooldown);
+    }
+    
+    void SetCooldown(SimpleZone zone, float duration)
+    {
+        zone.cooldownExpiry = m_Time + duration;
+        
+        SimpleCooldownEntry entry = new SimpleCooldownEntry();
+        entry.zone = zone;
+        entry.priority = zone.cooldownExpiry;
+        m_Cooldowns.Push(entry);
+    }
+    
+    void ClearCooldown(SimpleZone zone)
+    {
+        zone.cooldownExpiry = 0;
+    }
+    
+    bool IsCoolingDown(SimpleZone zone)
+    {
+        return zone.cooldownExpiry > 0;
+    }
+    
+    float GetCooldownRemaining(SimpleZone zone)
+    {
+        if (!IsCoolingDown(zone))
+            return 0;
+        
+        return Math.Max(zone.cooldownExpiry - m_Time, 0);
+    }
+    
+    void CheckPlayersOptimized()
+    {
+        if (m_Tiers.Count() == 0 || m_ZonesMap.Count() == 0)
+            return;
+        
+        if (m_ZoneWorkList.Count() > 0)
+        {
+            FinishZoneWork();
+        }
+        
+        m_CheckEpoch++;
+        m_FastPlayers = 0;
+        m_PlayersOnline = 0;
+        
+        int sampleCount = m_World.GetPlayerSamples(m_PlayerSamples);
+        m_PlayerGrid.Build(m_PlayerSamples, sampleCount);
+        
+        // Active zones are always re-checked so exits are never missed
+        array<SimpleZone> dirtyZones = m_DirtyZones;
+        dirtyZones.Clear();
+        for (int a = 0; a < m_ActiveZones.Count(); a++)
+        {
+            MarkZoneDirty(m_ActiveZones.Get(a), dirtyZones);
+        }
+        
+        // Only players that changed cell or moved far enough re-query the grid
+        float moveThresholdSq = PLAYER_MOVE_THRESHOLD * PLAYER_MOVE_THRESHOLD;
+        for (int p = 0; p < sampleCount; p++)
+        {
+            SimplePlayerSample sample = m_PlayerSamples.Get(p);
+            
+            int playerId = sample.id;
+            ref SimplePlayerState state;
+            if (!m_PlayerStates.Find(playerId, state))
+            {
+                state = new SimplePlayerState();
+                state.playerId = playerId;
+                m_PlayerStates.Set(playerId, state);
+            }
+            
+            state.lastSeenEpoch = m_CheckEpoch;
+            m_PlayersOnline++;
+            
+            vector playerPos = sample.position;
+            state.position = playerPos;
+            
+            if (state.hasSample)
+            {
+                float sampleDt = m_Time - state.sampleTime;
+                float fastDistance = FAST_PLAYER_SPEED * sampleDt;
+                if (sampleDt > 0 && vector.DistanceSq(playerPos, state.samplePosition) > fastDistance * fastDistance)
+                    m_FastPlayers++;
+            }
+            state.samplePosition = playerPos;
+            state.sampleTime = m_Time;
+            state.hasSample = true;
+            int cellKey = m_ZoneIndex.GetPlayerCellKey(playerPos);
+            
+            if (!state.needsRefresh && cellKey == state.lastCellKey && vector.DistanceSq(playerPos, state.lastPosition) < moveThresholdSq)
+                continue;
+            
+            state.needsRefresh = false;
+            state.lastCellKey = cellKey;
+            state.lastPosition = playerPos;
+            RefreshPlayerZones(state, dirtyZones);
+        }
+        
+        // Players that logged out, died or were deleted since the last check
+        array<int> goneIds = m_GoneIds;
+        goneIds.Clear();
+        for (int s = 0; s < m_PlayerStates.Count(); s++)
+        {
+            ref SimplePlayerState goneState = m_PlayerStates.GetElement(s);
+            if (goneState.lastSeenEpoch == m_CheckEpoch)
+                continue;
+            
+            for (int g = 0; g < goneState.zones.Count(); g++)
+            {
+                SimpleZone goneZone = goneState.zones.Get(g);
+                goneZone.nearbyPlayers.RemoveItem(goneState);
+                MarkZoneDirty(goneZone, dirtyZones);
+            }
+            goneIds.Insert(m_PlayerStates.GetKey(s));
+        }
+        
+        for (int r = 0; r < goneIds.Count(); r++)
+        {
+            m_PlayerStates.Remove(goneIds.Get(r));
+        }
+        
+        m_Metrics.AddWork(SimpleMetrics.PHASE_CHECK_PLAYERS, dirtyZones.Count(), m_PlayersOnline, 0);
+        
+        // Evaluate touched zones and rebuild the active set from them
+        m_ActiveZones.Clear();
+        
+        if (m_GlobalSettings.timeSlicedChecks)
+        {
+            m_ZoneWorkList.Copy(dirtyZones);
+            m_ZoneWorkCursor = 0;
+            StartZoneWorkPump();
+            return;
+        }
+        
+        for (int d = 0; d < dirtyZones.Count(); d++)
+        {
+            EvaluateZone(dirtyZones.Get(d));
+        }
+    }
+    
+    void EvaluateZone(SimpleZone zone)
+    {
+        int zoneTicks = TickCount(0);
+        CheckZone(zone);
+        m_Metrics.Record(SimpleMetrics.PHASE_CHECK_ZONE, zoneTicks);
+        m_Metrics.AddWork(SimpleMetrics.PHASE_CHECK_ZONE, 1, zone.nearbyPlayers.Count(), zone.liveEntities);
+        
+        // Zones waiting out their despawn grace stay active after the last player has left reach
+        if (zone.nearbyPlayers.Count() > 0 || zone.emptySince >= 0)
+        {
+            m_ActiveZones.Insert(zone);
+        }
+    }
+    
+    void StartZoneWorkPump()
+    {
+        if (m_ZoneWorkPumpActive)
+            return;
+        
+        m_ZoneWorkPumpActive = true;
+        m_World.GetCallQueue().CallLater(ProcessZoneWork, ZONE_WORK_TICK_MS, true);
+    }
+    
+    void StopZoneWorkPump()
+    {
+        if (!m_ZoneWorkPumpActive)
+            return;
         
-        ref SpawnPointConfig sp5 = new SpawnPointConfig();
-        sp5.position = "-990 -48.5 -1000";
-        sp5.radius = 1.5;
-        sp5.tierIds.Insert(1);
-        sp5.tierIds.Insert(2);
-        sp5.entities = 3;
-        sp5.useFixedHeight = true;
-        zone2.spawnPoints.Insert(sp5);
+        m_ZoneWorkPumpActive = false;
+        m_World.GetCallQueue().Remove(ProcessZoneWork);
+    }
+    
+    // Evaluates the next slice of the work list within the per-tick zone and time budget
+    void ProcessZoneWork()
+    {
+        int startTicks = TickCount(0);
+        int processed = 0;
         
-        ref SpawnPointConfig sp6 = new SpawnPointConfig();
-        sp6.position = "-1010 -48.5 -1005";
-        sp6.radius = 2.5;
-        sp6.tierIds.Insert(2);
-        sp6.entities = 1;
-        sp6.useFixedHeight = true;
-        zone2.spawnPoints.Insert(sp6);
+        while (m_ZoneWorkCursor < m_ZoneWorkList.Count())
+        {
+            if (m_GlobalSettings.zonesPerTick > 0 && processed >= m_GlobalSettings.zonesPerTick)
+                break;
+            
+            if (m_GlobalSettings.zoneBudgetMs > 0 && processed > 0 && TickCount(startTicks) / 10000.0 >= m_GlobalSettings.zoneBudgetMs)
+                break;
+            
+            SimpleZone zone = m_ZoneWorkList.Get(m_ZoneWorkCursor);
+            m_ZoneWorkCursor++;
+            
+            // Removed by a reload since the cycle started
+            if (!zone)
+                continue;
+            
+            EvaluateZone(zone);
+            processed++;
+        }
         
-        container.zones.Insert(zone2);
+        m_ZoneWorkMs += TickCount(startTicks) / 10000.0;
         
-        JsonFileLoader<ZonesContainer>.JsonSaveFile(filePath, container);
-        Print("[SpawnManager] Created default Zones.json with 2 example zones");
+        if (m_ZoneWorkCursor >= m_ZoneWorkList.Count())
+        {
+            m_ZoneWorkList.Clear();
+            m_ZoneWorkCursor = 0;
+            StopZoneWorkPump();
+        }
+    }
+    
+    // Finishes the previous cycle without a budget, so no zone waits longer than one interval
+    void FinishZoneWork()
+    {
+        for (int i = m_ZoneWorkCursor; i < m_ZoneWorkList.Count(); i++)
+        {
+            SimpleZone zone = m_ZoneWorkList.Get(i);
+            if (zone)
+                EvaluateZone(zone);
+        }
+        
+        m_ZoneWorkList.Clear();
+        m_ZoneWorkCursor = 0;
+        StopZoneWorkPump();
+    }
+    
+    void RefreshPlayerZones(SimplePlayerState state, array<SimpleZone> dirtyZones)
+    {
+        // Drop zones the player has moved out of
+        for (int i = state.zones.Count() - 1; i >= 0; i--)
+        {
+            SimpleZone oldZone = state.zones.Get(i);
+            if (!IsWithinReach(oldZone, state.lastPosition))
+            {
+                state.zones.Remove(i);
+                oldZone.nearbyPlayers.RemoveItem(state);
+                MarkZoneDirty(oldZone, dirtyZones);
+            }
+        }
+        
+        // The index returns exactly the zones whose reach contains the player
+        array<SimpleZone> candidates = m_QueryResults;
+        candidates.Clear();
+        m_ZoneIndex.Query(state.lastPosition, candidates);
+        
+        for (int z = 0; z < candidates.Count(); z++)
+        {
+            SimpleZone zone = candidates.Get(z);
+            if (!zone.enabled || state.zones.Find(zone) != -1)
+                continue;
+            
+            state.zones.Insert(zone);
+            zone.nearbyPlayers.Insert(state);
+            MarkZoneDirty(zone, dirtyZones);
+        }
+    }
+    
+    void CheckZone(SimpleZone zone)
+    {
+        int id = zone.id;
+        bool wasEmpty = (zone.playersInside.Count() == 0);
+        bool playerWithinDespawn = false;
+        float zoneX = m_ZoneX.Get(id);
+        float zoneY = m_ZoneY.Get(id);
+        float zoneZ = m_ZoneZ.Get(id);
+        float triggerSq = m_ZoneTriggerSq.Get(id);
+        
+        // Once occupied, players count as inside until they pass the exit radius
+        if (!wasEmpty)
+            triggerSq = Math.Max(triggerSq, m_ZoneExitSq.Get(id));
+        
+        float despawnSq = m_ZoneDespawnSq.Get(id);
+        float borderInnerSq = m_ZoneBorderInnerSq.Get(id);
+        float borderOuterSq = m_ZoneBorderOuterSq.Get(id);
+        
+        zone.playersInside.Clear();
+        
+        // Only players tracked near this zone can be inside it
+        for (int i = 0; i < zone.nearbyPlayers.Count(); i++)
+        {
+            SimplePlayerState player = zone.nearbyPlayers.Get(i);
+            vector playerPos = player.position;
+            float dx = playerPos[0] - zoneX;
+            float dy = playerPos[1] - zoneY;
+            float dz = playerPos[2] - zoneZ;
+            float distSq = dx * dx + dy * dy + dz * dz;
+            
+            if (distSq <= despawnSq)
+                playerWithinDespawn = true;
+            
+            if (distSq >= borderInnerSq && distSq <= borderOuterSq)
+                m_PlayersNearBorder++;
+            
+            if (distSq <= triggerSq)
+            {
+                zone.playersInside.Insert(player);
+            }
+        }
+        
+        bool isEmpty = (zone.playersInside.Count() == 0);
+        
+        if (!isEmpty)
+        {
+            // Players are back, a pending despawn is called off
+            zone.emptySince = -1;
+            
+            // Players entered, the zone arms and spawns once they have stayed for armingDelay
+            if (wasEmpty)
+                zone.armedSince = m_Time;
+            
+            if (zone.armedSince >= 0 && m_Time - zone.armedSince >= zone.armingDelay)
+            {
+                zone.armedSince = -1;
+                
+                int spawnTicks = TickCount(0);
+                TrySpawnInZone(zone, zone.playersInside);
+                m_Metrics.Record(SimpleMetrics.PHASE_TRY_SPAWN, spawnTicks);
+                m_Metrics.AddWork(SimpleMetrics.PHASE_TRY_SPAWN, 1, zone.playersInside.Count(), zone.pendingSpawns);
+            }
+            return;
+        }
+        
+        zone.armedSince = -1;
+        
+        // Nobody inside and nobody within despawn distance for despawnGrace seconds
+        if (zone.despawnOnExit && !playerWithinDespawn && (CountZoneEntities(zone) > 0 || zone.pendingSpawns > 0))
+        {
+            if (zone.emptySince < 0)
+                zone.emptySince = m_Time;
+            
+            if (m_Time - zone.emptySince < zone.despawnGrace)
+                return;
+            
+            zone.emptySince = -1;
+            
+            if (m_GlobalSettings.virtualPopulationEnabled)
+                VirtualizeZone(zone);
+            else
+                DespawnFromZone(zone);
+        }
+        else
+        {
+            zone.emptySince = -1;
+        }
+    }
+    
+    void TrySpawnInZone(ref SimpleZone zone, array<SimplePlayerState> playersInZone)
+    {
+        // Check cooldown
+        if (IsCoolingDown(zone))
+            return;
+        
+        // Check if already spawned
+        if (zone.hasSpawned)
+            return;
+        
+        // The previous creatures are still being deleted; spawning or materializing now would
+        // put a second set next to them
+        if (zone.queuedDespawns > 0)
+            return;
+        
+        // Survivors of the last visit come back instead of a new wave until the zone restocks
+        if (zone.virtualCount > 0)
+        {
+            if (m_Time - zone.virtualSince < zone.respawnCooldown)
+            {
+                MaterializeZone(zone, playersInZone);
+                return;
+            }
+            
+            ClearVirtualPopulation(zone);
+        }
+        
+        // Roll spawn chance
+        if (!zone.hasRolledChance)
+        {
+            float roll = Math.RandomFloat(0.0, 1.0);
+            zone.hasRolledChance = true;
+            
+            if (roll > zone.spawnChance)
+            {
+                SpawnLog().Debug("Zone %1 failed spawn chance", zone.name);
+                StartCooldown(zone);
+                return;
+            }
+        }
+        
+        if (!zone.spawnPoints || zone.spawnPoints.Count() == 0)
+            return;
+        
+        int currentTotal = CountZoneEntities(zone);
+        if (currentTotal > 0 || zone.pendingSpawns > 0)
+            return;
+        
+        int zoneBudget = GetZoneBudget();
+        int totalQueued = 0;
+        
+        for (int i = 0; i < zone.spawnPoints.Count(); i++)
+        {
+            ref SimpleSpawnPoint point = zone.spawnPoints.Get(i);
+            
+            if (point.tiers.Count() == 0 || !IsSpawnPointSafe(point, playersInZone))
+                continue;
+            
+            float priority = GetClosestPlayerDistanceSq(point.position, playersInZone);
+            
+            for (int j = 0; j < point.entities; j++)
+            {
+                if (zoneBudget > 0 && totalQueued >= zoneBudget)
+                    break;
+                
+                SimpleSpawnJob job = new SimpleSpawnJob();
+                job.zone = zone;
+                job.point = point;
+                job.wave = zone.spawnWave;
+                job.priority = priority;
+                m_SpawnQueue.Push(job);
+                totalQueued++;
+            }
+        }
+        
+        if (totalQueued > 0)
+        {
+            zone.hasSpawned = true;
+            zone.pendingSpawns = totalQueued;
+            zone.waveSpawned = 0;
+            StartSpawnPump();
+        }
+    }
+    
+    float GetClosestPlayerDistanceSq(vector pos, array<SimplePlayerState> players)
+    {
+        float closest = 999999.0 * 999999.0;
+        for (int i = 0; i < players.Count(); i++)
+        {
+            SimplePlayerState player = players.Get(i);
+            if (player)
+            {
+                float distSq = vector.DistanceSq(player.position, pos);
+                if (distSq < closest)
+                    closest = distSq;
+            }
+        }
+        return closest;
+    }
+    
+    void StartSpawnPump()
+    {
+        if (m_SpawnPumpActive)
+            return;
+        
+        m_SpawnPumpActive = true;
+        m_World.GetCallQueue().CallLater(ProcessSpawnQueue, SPAWN_QUEUE_TICK_MS, true);
+    }
+    
+    void StopSpawnPump()
+    {
+        if (!m_SpawnPumpActive)
+            return;
+        
+        m_SpawnPumpActive = false;
+        m_World.GetCallQueue().Remove(ProcessSpawnQueue);
+    }
+    
+    // Drains queued spawns within the per-tick entity and time budget
+    void ProcessSpawnQueue()
+    {
+        int startTicks = TickCount(0);
+        int attempts = 0;
+        
+        while (m_SpawnQueue.Count() > 0)
+        {
+            if (m_GlobalSettings.spawnsPerTick > 0 && attempts >= m_GlobalSettings.spawnsPerTick)
+                break;
+            
+            if (m_GlobalSettings.spawnBudgetMs > 0 && attempts > 0 && TickCount(startTicks) / 10000.0 >= m_GlobalSettings.spawnBudgetMs)
+                break;
+            
+            SimpleSpawnJob job = SimpleSpawnJob.Cast(m_SpawnQueue.Pop());
+            SimpleZone zone = job.zone;
+            
+            // Zone was despawned or reloaded since the job was queued
+            if (!zone || !job.point || job.wave != zone.spawnWave)
+                continue;
+            
+            attempts++;
+            zone.pendingSpawns--;
+            
+            // Global budget exhausted: make room from a less important zone or drop the job.
+            // Jobs pop nearest-to-player first, so the closest zones get the remaining budget.
+            bool hasBudget = HasGlobalBudget();
+            if (!hasBudget)
+            {
+                hasBudget = ReclaimEntityFor(zone, job.priority);
+            }
+            
+            bool spawned = false;
+            if (hasBudget && job.creature)
+                spawned = MaterializeCreature(zone, job.point, job.creature);
+            else if (hasBudget)
+                spawned = SpawnEntityAtPoint(zone, job.point);
+            
+            if (spawned)
+            {
+                zone.waveSpawned++;
+            }
+            
+            if (zone.pendingSpawns == 0)
+            {
+                FinishSpawnWave(zone);
+            }
+        }
+        
+        if (m_SpawnQueue.Count() == 0)
+        {
+            StopSpawnPump();
+        }
+    }
+    
+    void FinishSpawnWave(SimpleZone zone)
+    {
+        if (zone.waveSpawned > 0)
+        {
+            SpawnLog().Debug("Spawned %1 entities in zone %2", zone.waveSpawned, zone.name);
+            
+            // Everything may already have died while the wave was still queued
+            CheckZoneCleared(zone);
+        }
+        else
+        {
+            // Nothing could be created, allow the next entry to try again
+            zone.hasSpawned = false;
+        }
+    }
+    
+    // Drops queued jobs of the zone, returns true if any were pending
+    bool CancelPendingSpawns(SimpleZone zone)
+    {
+        bool hadPending = (zone.pendingSpawns > 0);
+        zone.spawnWave++;
+        zone.pendingSpawns = 0;
+        return hadPending;
+    }
+    
+    int GetZoneBudget()
+    {
+        return m_GlobalSettings.maxEntitiesPerZone;
+    }
+    
+    // Creatures waiting in the despawn queue are still in the world and count against the budget
+    bool HasGlobalBudget()
+    {
+        return m_GlobalSettings.maxTotalEntities <= 0 || m_TrackedEntities.Count() + m_DespawnQueue.Count() < m_GlobalSettings.maxTotalEntities;
+    }
+    
+    // The zone's nearby list is small; a grid query over its whole reach is not
+    float GetZoneClosestPlayerDistanceSq(SimpleZone zone)
+    {
+        float closest = 999999.0 * 999999.0;
+        for (int i = 0; i < zone.nearbyPlayers.Count(); i++)
+        {
+            SimplePlayerState state = zone.nearbyPlayers.Get(i);
+            if (state)
+            {
+                float distSq = vector.DistanceSq(state.position, zone.position);
+                if (distSq < closest)
+                    closest = distSq;
+            }
+        }
+        return closest;
+    }
+    
+    // Frees one slot of the global budget for a spawn at the given player distance. Creatures
+    // of zones without nearby players go first, then those of zones farther from their players
+    // than the requesting spawn. Returns false if nothing is less important than the request.
+    // The victim zone is chosen first, with one distance per zone, then one of its creatures.
+    bool ReclaimEntityFor(SimpleZone requester, float prioritySq)
+    {
+        SimpleZone victimZone = null;
+        float victimDistSq = prioritySq;
+        
+        for (int i = 0; i < m_ZoneList.Count(); i++)
+        {
+            SimpleZone zone = m_ZoneList.Get(i);
+            if (zone.liveEntities == 0)
+                continue;
+            
+            if (zone.nearbyPlayers.Count() == 0)
+            {
+                victimZone = zone;
+                break;
+            }
+            
+            if (zone == requester)
+                continue;
+            
+            float distSq = GetZoneClosestPlayerDistanceSq(zone);
+            if (distSq > victimDistSq)
+            {
+                victimZone = zone;
+                victimDistSq = distSq;
+            }
+        }
+        
+        if (!victimZone)
+            return false;
+        
+        SimpleSpawnedEntity victim = null;
+        for (int j = 0; j < victimZone.spawnPoints.Count() && !victim; j++)
+        {
+            SimpleSpawnPoint point = victimZone.spawnPoints.Get(j);
+            if (point.spawnedEntities.Count() > 0)
+                victim = point.spawnedEntities.Get(point.spawnedEntities.Count() - 1);
+        }
+        
+        if (!victim)
+            return false;
+        
+        RemoveTrackedEntity(victim);
+        if (victim.entity)
+        {
+            ReleaseEntity(victim.entity);
+        }
+        
+        m_ReclaimedEntities++;
+        return true;
+    }
+    
+    // Checks every player near the point, not just those inside the zone. The listed players
+    // are tested too, for callers whose players are not in the latest snapshot.
+    bool IsSpawnPointSafe(ref SimpleSpawnPoint point, array<SimplePlayerState> players)
+    {
+        float minDistSq = m_MinSpawnDistanceFromPlayer * m_MinSpawnDistanceFromPlayer;
+        
+        float closestSq = m_PlayerGrid.ClosestDistanceSq(point.position, m_MinSpawnDistanceFromPlayer);
+        if (closestSq >= 0 && closestSq < minDistSq)
+            return false;
+        
+        for (int i = 0; i < players.Count(); i++)
+        {
+            SimplePlayerState player = players.Get(i);
+            if (player && vector.DistanceSq(player.position, point.position) < minDistSq)
+                return false;
+        }
+        return true;
     }
     
-    void LoadAllConfigs()
+    bool SpawnEntityAtPoint(ref SimpleZone zone, ref SimpleSpawnPoint point)
     {
-        Print("[SpawnManager] === LOADING CONFIGURATIONS ===");
+        if (point.tiers.Count() == 0)
+            return false;
         
-        m_Tiers.Clear();
-        m_ZonesMap.Clear();
-        m_ZoneGrid.Clear();
+        if (point.spawnedEntities.Count() >= point.entities)
+            return false;
         
-        LoadTiers();
-        LoadZones();
-        BuildSpatialGrid();
+        int zoneBudget = GetZoneBudget();
+        if (zoneBudget > 0 && zone.liveEntities >= zoneBudget)
+            return false;
         
-        Print("[SpawnManager] Configuration loaded:");
-        Print("[SpawnManager] - Tiers: " + m_Tiers.Count().ToString());
-        Print("[SpawnManager] - Zones: " + m_ZonesMap.Count().ToString());
-        Print("[SpawnManager] === SYSTEM READY ===");
-    }
-    
-    void LoadTiers()
-    {
-        string tiersPath = "$profile:MutantSpawnSystem/Tiers.json";
+        SimpleTier tier = point.tiers.Get(point.tierTable.Sample());
+        if (!tier)
+            return false;
         
-        if (!FileExist(tiersPath))
+        string entityClass = tier.classnames.Get(tier.classTable.Sample());
+        
+        if (!point.candidatesBuilt)
         {
-            Print("[SpawnManager] ERROR: Tiers.json not found!");
-            return;
+            BuildSpawnCandidates(point);
         }
         
-        ref TiersContainer container = new TiersContainer();
-        JsonFileLoader<TiersContainer>.JsonLoadFile(tiersPath, container);
-        
-        if (container && container.tiers && container.tiers.Count() > 0)
+        vector spawnPos;
+        int candidate = PickSpawnCandidate(point);
+        if (candidate >= 0)
         {
-            for (int i = 0; i < container.tiers.Count(); i++)
-            {
-                int tierId = container.tiers.GetKey(i);
-                ref TierConfig config = container.tiers.GetElement(i);
-                
-                if (config)
-                {
-                    ref SimpleTier tier = new SimpleTier();
-                    tier.name = config.name;
-                    
-                    for (int j = 0; j < config.classnames.Count(); j++)
-                    {
-                        tier.classnames.Insert(config.classnames.Get(j));
-                    }
-                    
-                    m_Tiers.Set(tierId, tier);
-                    Print("[SpawnManager] Loaded tier " + tierId.ToString() + ": " + tier.name);
-                }
-            }
+            spawnPos = point.candidates.Get(candidate);
+        }
+        else
+        {
+            // Nothing passed validation or every candidate is held, fall back to a random position
+            spawnPos = RollSpawnPosition(point);
         }
+        spawnPos[1] = spawnPos[1] + 0.5;
+        
+        return CreateTrackedEntity(zone, point, entityClass, spawnPos, candidate, 1.0) != null;
     }
     
-    void LoadZones()
+    // Creates or recycles the entity and starts tracking it; health is a fraction of max health
+    EntityAI CreateTrackedEntity(SimpleZone zone, SimpleSpawnPoint point, string entityClass, vector spawnPos, int candidate, float health)
     {
-        string zonesPath = "$profile:MutantSpawnSystem/Zones.json";
-        
-        if (!FileExist(zonesPath))
+        EntityAI entity = null;
+        if (m_EntityPool.IsEnabled())
         {
-            Print("[SpawnManager] ERROR: Zones.json not found!");
-            return;
+            entity = m_EntityPool.Acquire(entityClass, spawnPos);
         }
         
-        ref ZonesContainer container = new ZonesContainer();
-        JsonFileLoader<ZonesContainer>.JsonLoadFile(zonesPath, container);
+        if (!entity)
+        {
+            entity = m_World.CreateEntity(entityClass, spawnPos);
+        }
         
-        if (container)
+        if (entity)
         {
-            if (container.globalSettings)
+            entity.SetHealth("", "", entity.GetMaxHealth("", "") * health);
+            
+            SimpleSpawnedEntity record = new SimpleSpawnedEntity();
+            record.entity = entity;
+            record.entityId = entity.GetID();
+            record.zone = zone;
+            record.point = point;
+            
+            if (candidate >= 0 && !point.candidateTaken.Get(candidate))
             {
-                m_GlobalSettings = container.globalSettings;
-                m_SystemEnabled = m_GlobalSettings.systemEnabled;
-                m_CheckInterval = m_GlobalSettings.checkInterval;
-                m_MinSpawnDistanceFromPlayer = m_GlobalSettings.minSpawnDistanceFromPlayer;
-                
-                Print("[SpawnManager] Loaded global settings");
+                record.candidate = candidate;
+                point.candidateTaken.Set(candidate, true);
             }
             
-            if (container.zones && container.zones.Count() > 0)
+            TrackEntity(record);
+            
+            if (m_GlobalSettings.entityLifetime > 0)
             {
-                for (int i = 0; i < container.zones.Count(); i++)
-                {
-                    ref ZoneConfig config = container.zones.Get(i);
-                    if (config)
-                    {
-                        ref SimpleZone zone = new SimpleZone();
-                        zone.name = config.name;
-                        zone.enabled = config.enabled;
-                        zone.position = config.position.ToVector();
-                        zone.triggerRadius = config.triggerRadius;
-                        zone.spawnChance = config.spawnChance;
-                        zone.despawnOnExit = config.despawnOnExit;
-                        zone.despawnDistance = config.despawnDistance;
-                        zone.respawnCooldown = config.respawnCooldown;
-                        
-                        int totalEntities = 0;
-                        
-                        for (int j = 0; j < config.spawnPoints.Count(); j++)
-                        {
-                            ref SpawnPointConfig spConfig = config.spawnPoints.Get(j);
-                            if (spConfig)
-                            {
-                                ref SimpleSpawnPoint sp = new SimpleSpawnPoint();
-                                sp.position = spConfig.position.ToVector();
-                                sp.radius = spConfig.radius;
-                                sp.entities = spConfig.entities;
-                                sp.useFixedHeight = spConfig.useFixedHeight;
-                                totalEntities += spConfig.entities;
-                                
-                                for (int k = 0; k < spConfig.tierIds.Count(); k++)
-                                {
-                                    sp.tierIds.Insert(spConfig.tierIds.Get(k));
-                                }
-                                
-                                zone.spawnPoints.Insert(sp);
-                            }
-                        }
-                        
-                        m_ZonesMap.Set(zone.name, zone);
-                        
-                        Print("[SpawnManager] Loaded zone: " + zone.name);
-                        Print("[SpawnManager]   Spawn chance: " + (zone.spawnChance * 100).ToString() + "%");
-                        Print("[SpawnManager]   Spawn points: " + zone.spawnPoints.Count().ToString() + " (Total entities: " + totalEntities.ToString() + ")");
-                    }
-                }
+                m_LifetimeWheel.Schedule(record, m_GlobalSettings.entityLifetime);
             }
         }
+        
+        return entity;
     }
     
-    void BuildSpatialGrid()
+    // Random ground position inside the point's radius
+    vector RollSpawnPosition(SimpleSpawnPoint point)
     {
-        // Build spatial grid for optimized zone lookups
-        for (int i = 0; i < m_ZonesMap.Count(); i++)
+        vector spawnPos = point.position;
+        if (point.radius > 0)
         {
-            ref SimpleZone zone = m_ZonesMap.GetElement(i);
-            if (zone)
-            {
-                // Calculate grid cells that this zone overlaps
-                float radius = zone.triggerRadius + zone.despawnDistance;
-                int minX = Math.Floor((zone.position[0] - radius) / GRID_SIZE);
-                int maxX = Math.Floor((zone.position[0] + radius) / GRID_SIZE);
-                int minZ = Math.Floor((zone.position[2] - radius) / GRID_SIZE);
-                int maxZ = Math.Floor((zone.position[2] + radius) / GRID_SIZE);
-                
-                // Add zone to all overlapping grid cells
-                for (int x = minX; x <= maxX; x++)
-                {
-                    for (int z = minZ; z <= maxZ; z++)
-                    {
-                        int gridKey = (x * 10000) + z;  // Simple hash
-                        
-                        ref array<ref SimpleZone> cellZones;
-                        if (!m_ZoneGrid.Find(gridKey, cellZones))
-                        {
-                            cellZones = new array<ref SimpleZone>;
-                            m_ZoneGrid.Set(gridKey, cellZones);
-                        }
-                        cellZones.Insert(zone);
-                    }
-                }
-            }
+            float angle = Math.RandomFloat(0, Math.PI2);
+            float distance = point.radius * Math.Sqrt(Math.RandomFloat01());
+            spawnPos[0] = spawnPos[0] + (Math.Cos(angle) * distance);
+            spawnPos[2] = spawnPos[2] + (Math.Sin(angle) * distance);
+        }
+        
+        if (!point.useFixedHeight)
+        {
+            spawnPos[1] = m_World.SurfaceY(spawnPos[0], spawnPos[2]);
         }
         
-        Print("[SpawnManager] Built spatial grid with " + m_ZoneGrid.Count().ToString() + " cells");
+        return spawnPos;
     }
     
-    void Update(float timeslice)
+    // Dart-throws well spaced positions inside the radius and keeps the ones on the navmesh
+    // with room for a creature. Runs once per point, so the validity queries are not repeated
+    // for every spawn.
+    void BuildSpawnCandidates(SimpleSpawnPoint point)
     {
-        if (!m_SystemEnabled) return;
+        point.candidatesBuilt = true;
+        point.candidates.Clear();
+        point.candidateTaken.Clear();
         
-        m_CheckTimer += timeslice;
+        int wanted = 1;
+        if (point.radius > 0)
+            wanted = Math.Min(Math.Max(point.entities * 2, 4), MAX_SPAWN_CANDIDATES);
         
-        // Update zone cooldowns
-        for (int i = 0; i < m_ZonesMap.Count(); i++)
+        // Roughly the spacing at which the wanted count still fits into the disc
+        float spacing = Math.Max(point.radius / Math.Sqrt(wanted), MIN_CANDIDATE_SPACING);
+        float spacingSq = spacing * spacing;
+        int rejected = 0;
+        
+        for (int attempt = 0; attempt < wanted * CANDIDATE_ATTEMPTS && point.candidates.Count() < wanted; attempt++)
         {
-            ref SimpleZone zone = m_ZonesMap.GetElement(i);
-            if (zone && zone.cooldownTime > 0)
+            vector position = point.position;
+            if (attempt > 0)
+                position = RollSpawnPosition(point);
+            else if (!point.useFixedHeight)
+                position[1] = m_World.SurfaceY(position[0], position[2]);
+            
+            bool tooClose = false;
+            for (int i = 0; i < point.candidates.Count(); i++)
             {
-                zone.cooldownTime -= timeslice;
-                if (zone.cooldownTime <= 0)
+                vector other = point.candidates.Get(i);
+                float dx = other[0] - position[0];
+                float dz = other[2] - position[2];
+                if (dx * dx + dz * dz < spacingSq)
                 {
-                    zone.cooldownTime = 0;
-                    zone.hasSpawned = false;
-                    zone.hasRolledChance = false;
+                    tooClose = true;
+                    break;
                 }
             }
+            
+            if (tooClose)
+                continue;
+            
+            vector resolved;
+            if (!m_World.ValidateSpawnPosition(position, resolved))
+            {
+                rejected++;
+                continue;
+            }
+            
+            point.candidates.Insert(resolved);
+            point.candidateTaken.Insert(false);
         }
         
-        // Check zones
-        if (m_CheckTimer >= m_CheckInterval)
+        if (point.candidates.Count() == 0)
         {
-            m_CheckTimer = 0.0;
-            CheckPlayersOptimized();
+            SpawnLog().Warning("No valid spawn position near %1 (%2 rejected)", point.position, rejected);
         }
     }
     
-    void CheckPlayersOptimized()
+    // A random free candidate, -1 if there are none or all are held
+    int PickSpawnCandidate(SimpleSpawnPoint point)
     {
-        if (m_Tiers.Count() == 0 || m_ZonesMap.Count() == 0)
-            return;
+        int count = point.candidates.Count();
+        if (count == 0)
+            return -1;
         
-        array<Man> players = new array<Man>;
-        GetGame().GetPlayers(players);
-        
-        if (players.Count() == 0)
-            return;
-        
-        // Track which zones have been checked
-        ref set<ref SimpleZone> checkedZones = new set<ref SimpleZone>;
-        
-        // For each player, only check zones in nearby grid cells
-        for (int p = 0; p < players.Count(); p++)
+        int start = Math.RandomInt(0, count);
+        for (int i = 0; i < count; i++)
         {
-            Man player = players.Get(p);
-            if (!player || !player.IsAlive())
-                continue;
-            
-            vector playerPos = player.GetPosition();
-            
-            // Get grid cell for player
-            int gridX = Math.Floor(playerPos[0] / GRID_SIZE);
-            int gridZ = Math.Floor(playerPos[2] / GRID_SIZE);
-            
-            // Check surrounding grid cells (3x3 area)
-            for (int dx = -1; dx <= 1; dx++)
-            {
-                for (int dz = -1; dz <= 1; dz++)
-                {
-                    int gridKey = ((gridX + dx) * 10000) + (gridZ + dz);
-                    
-                    ref array<ref SimpleZone> cellZones;
-                    if (m_ZoneGrid.Find(gridKey, cellZones))
-                    {
-                        for (int z = 0; z < cellZones.Count(); z++)
-                        {
-                            ref SimpleZone zone = cellZones.Get(z);
-                            
-                            // Skip if already checked
-                            if (checkedZones.Find(zone) != -1)
-                                continue;
-                            
-                            checkedZones.Insert(zone);
-                            
-                            if (!zone || !zone.enabled)
-                                continue;
-                            
-                            // Check this zone against all players
-                            CheckZone(zone, players);
-                        }
-                    }
-                }
-            }
+            int index = (start + i) % count;
+            if (!point.candidateTaken.Get(index))
+                return index;
         }
+        
+        return -1;
+    }
+    
+    void TrackEntity(SimpleSpawnedEntity record)
+    {
+        record.point.spawnedEntities.Insert(record);
+        record.zone.liveEntities++;
+        m_TrackedEntities.Set(record.entityId, record);
     }
     
-    void CheckZone(ref SimpleZone zone, array<Man> players)
+    // Drops the record from the tracker, the lifetime wheel and its zone counter.
+    // The caller removes it from the spawn point's list.
+    void UntrackEntity(SimpleSpawnedEntity record)
     {
-        array<Man> currentPlayersInside = new array<Man>;
-        float closestPlayerDistance = 999999.0;
+        m_LifetimeWheel.Cancel(record);
         
-        // Check which players are in zone
-        for (int i = 0; i < players.Count(); i++)
+        if (record.point && record.candidate >= 0 && record.candidate < record.point.candidateTaken.Count())
         {
-            Man player = players.Get(i);
-            if (player && player.IsAlive())
-            {
-                float distSq = vector.DistanceSq(player.GetPosition(), zone.position);
-                float dist = Math.Sqrt(distSq);
-                
-                if (dist < closestPlayerDistance)
-                    closestPlayerDistance = dist;
-                
-                if (dist <= zone.triggerRadius)
-                {
-                    currentPlayersInside.Insert(player);
-                }
-            }
+            record.point.candidateTaken.Set(record.candidate, false);
         }
+        record.candidate = -1;
+        m_TrackedEntities.Remove(record.entityId);
         
-        // Check for state changes
-        bool wasEmpty = (zone.playersInside.Count() == 0);
-        bool isEmpty = (currentPlayersInside.Count() == 0);
-        
-        // Players entered
-        if (wasEmpty && !isEmpty)
-        {
-            zone.playersInside = currentPlayersInside;
-            TrySpawnInZone(zone, currentPlayersInside);
-        }
-        // Players left
-        else if (!wasEmpty && isEmpty)
-        {
-            zone.playersInside.Clear();
-            if (zone.despawnOnExit && closestPlayerDistance > zone.despawnDistance)
-            {
-                DespawnFromZone(zone);
-            }
-        }
-        // Update player list
-        else
+        if (record.zone)
         {
-            zone.playersInside = currentPlayersInside;
+            record.zone.liveEntities--;
         }
     }
     
-    void TrySpawnInZone(ref SimpleZone zone, array<Man> playersInZone)
+    void RemoveTrackedEntity(SimpleSpawnedEntity record)
     {
-        // Check cooldown
-        if (zone.cooldownTime > 0)
-            return;
-        
-        // Check if already spawned
-        if (zone.hasSpawned)
-            return;
+        UntrackEntity(record);
         
-        // Roll spawn chance
-        if (!zone.hasRolledChance)
+        // Point is gone if the zone was reloaded since the spawn
+        if (record.point)
         {
-            float roll = Math.RandomFloat(0.0, 1.0);
-            zone.hasRolledChance = true;
-            
-            if (roll > zone.spawnChance)
+            int index = record.point.spawnedEntities.Find(record);
+            if (index != -1)
             {
-                Print("[SpawnManager] Zone " + zone.name + " failed spawn chance");
-                zone.cooldownTime = zone.respawnCooldown;
-                return;
+                record.point.spawnedEntities.Remove(index);
             }
         }
         
-        if (!zone.spawnPoints || zone.spawnPoints.Count() == 0)
+        CheckZoneCleared(record.zone);
+    }
+    
+    // Starts the respawn cooldown as soon as the last creature of a wave is gone
+    void CheckZoneCleared(SimpleZone zone)
+    {
+        if (zone && zone.liveEntities == 0 && zone.hasSpawned && zone.pendingSpawns == 0)
+        {
+            StartCooldown(zone);
+            zone.hasSpawned = false;
+            zone.hasRolledChance = false;
+        }
+    }
+    
+    // Called from the entity death and deletion hooks for every creature, tracked or not
+    void OnTrackedEntityGone(EntityAI entity)
+    {
+        SimpleSpawnedEntity record;
+        if (!m_TrackedEntities.Find(entity.GetID(), record))
             return;
         
-        CleanupSpawnPointEntities(zone);
-        
-        int currentTotal = CountZoneEntities(zone);
-        if (currentTotal > 0)
+        if (!record || record.entity != entity)
             return;
         
-        int totalSpawned = 0;
-        
+        RemoveTrackedEntity(record);
+    }
+    
+    void CleanupSpawnPointEntities(ref SimpleZone zone)
+    {
         for (int i = 0; i < zone.spawnPoints.Count(); i++)
         {
             ref SimpleSpawnPoint point = zone.spawnPoints.Get(i);
             
-            if (!IsSpawnPointSafe(point, playersInZone))
-                continue;
-            
-            for (int j = 0; j < point.entities; j++)
+            for (int j = point.spawnedEntities.Count() - 1; j >= 0; j--)
             {
-                if (SpawnEntityAtPoint(zone, point))
+                SimpleSpawnedEntity record = point.spawnedEntities.Get(j);
+                if (!record.entity || !record.entity.IsAlive())
                 {
-                    totalSpawned++;
+                    UntrackEntity(record);
+                    point.spawnedEntities.Remove(j);
                 }
             }
         }
+    }
+    
+    int CountZoneEntities(ref SimpleZone zone)
+    {
+        return zone.liveEntities;
+    }
+    
+    void DespawnFromZone(ref SimpleZone zone)
+    {
+        int startTicks = TickCount(0);
+        bool hadPending = CancelPendingSpawns(zone);
+        ClearVirtualPopulation(zone);
+        int totalDespawned = 0;
+        
+        // The zone is empty as far as bookkeeping goes; the queue deletes the creatures over the next ticks
+        for (int i = 0; i < zone.spawnPoints.Count(); i++)
+        {
+            totalDespawned += RetirePointEntities(zone.spawnPoints.Get(i));
+        }
         
-        if (totalSpawned > 0)
+        if (totalDespawned > 0 || hadPending)
         {
-            zone.hasSpawned = true;
-            Print("[SpawnManager] Spawned " + totalSpawned.ToString() + " entities in zone " + zone.name);
+            StartCooldown(zone);
+            zone.hasSpawned = false;
+            zone.hasRolledChance = false;
+            SpawnLog().Debug("Queued %1 entities of zone %2 for despawn", totalDespawned, zone.name);
         }
+        
+        m_Metrics.Record(SimpleMetrics.PHASE_DESPAWN, startTicks);
+        m_Metrics.AddWork(SimpleMetrics.PHASE_DESPAWN, 1, 0, totalDespawned);
     }
     
-    bool IsSpawnPointSafe(ref SimpleSpawnPoint point, array<Man> players)
+    // Replaces the zone's creatures with records of their class, health and position. The zone
+    // keeps no cooldown while virtual; players returning before respawnCooldown has passed get
+    // the survivors back, later visits restock the zone with a fresh wave.
+    void VirtualizeZone(SimpleZone zone)
     {
-        for (int i = 0; i < players.Count(); i++)
+        CancelPendingSpawns(zone);
+        int virtualized = 0;
+        
+        for (int i = 0; i < zone.spawnPoints.Count(); i++)
         {
-            Man player = players.Get(i);
-            if (player && player.IsAlive())
+            SimpleSpawnPoint point = zone.spawnPoints.Get(i);
+            
+            for (int j = 0; j < point.spawnedEntities.Count(); j++)
             {
-                float distance = vector.Distance(player.GetPosition(), point.position);
-                if (distance < m_MinSpawnDistanceFromPlayer)
+                SimpleSpawnedEntity record = point.spawnedEntities.Get(j);
+                
+                if (record.entity && record.entity.IsAlive())
                 {
-                    return false;
+                    SimpleVirtualCreature creature = new SimpleVirtualCreature();
+                    creature.classname = record.entity.GetType();
+                    creature.health = record.entity.GetHealth01("", "");
+                    creature.position = record.entity.GetPosition();
+                    point.virtualCreatures.Insert(creature);
+                    virtualized++;
                 }
             }
-        }
-        return true;
-    }
-    
-    bool SpawnEntityAtPoint(ref SimpleZone zone, ref SimpleSpawnPoint point)
-    {
-        if (point.tierIds.Count() == 0)
-            return false;
-        
-        if (point.spawnedEntities.Count() >= point.entities)
-            return false;
-        
-        int tierIndex = Math.RandomInt(0, point.tierIds.Count());
-        int tierId = point.tierIds.Get(tierIndex);
-        
-        ref SimpleTier tier;
-        if (!m_Tiers.Find(tierId, tier) || !tier || tier.classnames.Count() == 0)
-            return false;
+            
+            RetirePointEntities(point);
+        }
         
-        int classIndex = Math.RandomInt(0, tier.classnames.Count());
-        string entityClass = tier.classnames.Get(classIndex);
+        zone.virtualCount += virtualized;
+        zone.virtualSince = m_Time;
+        zone.hasSpawned = false;
+        zone.hasRolledChance = false;
         
-        vector spawnPos = point.position;
-        if (point.radius > 0)
+        if (zone.virtualCount == 0)
         {
-            float angle = Math.RandomFloat(0, Math.PI2);
-            float distance = Math.RandomFloat(0, point.radius);
-            spawnPos[0] = spawnPos[0] + (Math.Cos(angle) * distance);
-            spawnPos[2] = spawnPos[2] + (Math.Sin(angle) * distance);
+            // Everything was killed, so this is a cleared zone
+            StartCooldown(zone);
         }
         
-        if (point.useFixedHeight)
-        {
-            spawnPos[1] = point.position[1] + 0.5;
-        }
-        else
-        {
-            spawnPos[1] = GetGame().SurfaceY(spawnPos[0], spawnPos[2]) + 0.5;
-        }
+        SpawnLog().Debug("Virtualized %1 entities in zone %2", virtualized, zone.name);
+    }
+    
+    // Queues the zone's virtual creatures like a wave, nearest to players first. They stay on
+    // their spawn point until created, so cancelled or dropped jobs leave them virtual.
+    void MaterializeZone(SimpleZone zone, array<SimplePlayerState> playersInZone)
+    {
+        if (CountZoneEntities(zone) > 0 || zone.pendingSpawns > 0)
+            return;
         
-        EntityAI entity = EntityAI.Cast(GetGame().CreateObject(entityClass, spawnPos, false, true, true));
+        int totalQueued = 0;
         
-        if (entity)
+        for (int i = 0; i < zone.spawnPoints.Count(); i++)
         {
-            entity.SetHealth("", "", entity.GetMaxHealth("", ""));
+            SimpleSpawnPoint point = zone.spawnPoints.Get(i);
+            if (point.virtualCreatures.Count() == 0)
+                continue;
             
-            point.spawnedEntities.Insert(entity);
+            float priority = GetClosestPlayerDistanceSq(point.position, playersInZone);
             
-            if (m_GlobalSettings.entityLifetime > 0)
+            for (int j = 0; j < point.virtualCreatures.Count(); j++)
             {
-                GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(CleanupEntity, m_GlobalSettings.entityLifetime * 1000, false, entity);
+                SimpleSpawnJob job = new SimpleSpawnJob();
+                job.zone = zone;
+                job.point = point;
+                job.wave = zone.spawnWave;
+                job.creature = point.virtualCreatures.Get(j);
+                job.priority = priority;
+                m_SpawnQueue.Push(job);
+                totalQueued++;
             }
-            
-            return true;
         }
         
-        return false;
+        if (totalQueued > 0)
+        {
+            zone.hasSpawned = true;
+            zone.hasRolledChance = true;
+            zone.pendingSpawns = totalQueued;
+            zone.waveSpawned = 0;
+            StartSpawnPump();
+        }
     }
     
-    void CleanupSpawnPointEntities(ref SimpleZone zone)
+    // Applies the time spent virtual and creates the entity. Regeneration and drift are
+    // evaluated once here instead of being simulated while nobody is around.
+    bool MaterializeCreature(SimpleZone zone, SimpleSpawnPoint point, SimpleVirtualCreature creature)
     {
-        for (int i = 0; i < zone.spawnPoints.Count(); i++)
+        float elapsedHours = (m_Time - zone.virtualSince) / 3600.0;
+        float health = Math.Min(creature.health + elapsedHours * m_GlobalSettings.virtualHealthRegenPerHour, 1.0);
+        
+        vector spawnPos = creature.position;
+        int candidate = -1;
+        
+        // Creatures that were left alone long enough have wandered back to their spawn point
+        if (m_Time - zone.virtualSince >= VIRTUAL_DRIFT_SECONDS)
         {
-            ref SimpleSpawnPoint point = zone.spawnPoints.Get(i);
+            if (!point.candidatesBuilt)
+            {
+                BuildSpawnCandidates(point);
+            }
             
-            for (int j = point.spawnedEntities.Count() - 1; j >= 0; j--)
+            candidate = PickSpawnCandidate(point);
+            if (candidate >= 0)
             {
-                EntityAI entity = point.spawnedEntities.Get(j);
-                if (!entity || !entity.IsAlive())
-                {
-                    point.spawnedEntities.Remove(j);
-                }
+                spawnPos = point.candidates.Get(candidate);
+                spawnPos[1] = spawnPos[1] + 0.5;
             }
         }
+        
+        if (!CreateTrackedEntity(zone, point, creature.classname, spawnPos, candidate, health))
+            return false;
+        
+        // Gone already if the population was cleared while the job was queued
+        int index = point.virtualCreatures.Find(creature);
+        if (index >= 0)
+        {
+            point.virtualCreatures.Remove(index);
+            zone.virtualCount--;
+        }
+        
+        return true;
     }
     
-    int CountZoneEntities(ref SimpleZone zone)
+    void ClearVirtualPopulation(SimpleZone zone)
     {
-        int count = 0;
+        if (zone.virtualCount == 0)
+            return;
+        
         for (int i = 0; i < zone.spawnPoints.Count(); i++)
         {
-            ref SimpleSpawnPoint point = zone.spawnPoints.Get(i);
-            count += point.spawnedEntities.Count();
+            zone.spawnPoints.Get(i).virtualCreatures.Clear();
         }
-        return count;
+        zone.virtualCount = 0;
     }
     
-    void DespawnFromZone(ref SimpleZone zone)
+    // Rare consistency check for entities whose death or deletion was not reported
+    void CleanupDeadEntities()
     {
-        int totalDespawned = 0;
+        int startTicks = TickCount(0);
+        int zonesSwept = 0;
+        int trackedBefore = m_TrackedEntities.Count();
         
-        for (int i = 0; i < zone.spawnPoints.Count(); i++)
+        for (int i = 0; i < m_ZoneList.Count(); i++)
         {
-            ref SimpleSpawnPoint point = zone.spawnPoints.Get(i);
-            
-            for (int j = 0; j < point.spawnedEntities.Count(); j++)
+            SimpleZone zone = m_ZoneList.Get(i);
+            if (zone.liveEntities > 0 || zone.hasSpawned)
             {
-                EntityAI entity = point.spawnedEntities.Get(j);
-                if (entity)
-                {
-                    entity.Delete();
-                    totalDespawned++;
-                }
+                CleanupSpawnPointEntities(zone);
+                CheckZoneCleared(zone);
+                zonesSwept++;
             }
-            point.spawnedEntities.Clear();
         }
         
-        if (totalDespawned > 0)
-        {
-            zone.cooldownTime = zone.respawnCooldown;
-            zone.hasSpawned = false;
-            zone.hasRolledChance = false;
-            Print("[SpawnManager] Despawned " + totalDespawned.ToString() + " entities from zone " + zone.name);
-        }
+        m_Metrics.Record(SimpleMetrics.PHASE_CLEANUP, startTicks);
+        m_Metrics.AddWork(SimpleMetrics.PHASE_CLEANUP, zonesSwept, 0, trackedBefore);
     }
     
-    void CleanupDeadEntities()
+    // Parks the entity for reuse if the pool has room, otherwise deletes it
+    void ReleaseEntity(EntityAI entity)
     {
-        for (int i = 0; i < m_ZonesMap.Count(); i++)
+        if (!m_EntityPool.Park(entity))
         {
-            ref SimpleZone zone = m_ZonesMap.GetElement(i);
-            if (zone)
-            {
-                CleanupSpawnPointEntities(zone);
-                
-                if (CountZoneEntities(zone) == 0 && zone.hasSpawned)
-                {
-                    zone.cooldownTime = zone.respawnCooldown;
-                    zone.hasSpawned = false;
-                    zone.hasRolledChance = false;
-                }
-            }
+            m_World.DeleteEntity(entity);
         }
     }
     
-    void CleanupEntity(EntityAI entity)
+    void OnEntityLifetimeExpired(SimpleSpawnedEntity record)
     {
-        if (entity)
+        RemoveTrackedEntity(record);
+        
+        if (record.entity)
         {
-            entity.Delete();
+            ReleaseEntity(record.entity);
         }
     }
     
     void ForceReload()
     {
-        Print("[SpawnManager] === FORCED RELOAD ===");
+        SpawnLog().Info("=== FORCED RELOAD ===");
         LoadAllConfigs();
     }
     
     void ToggleSystem()
     {
         m_SystemEnabled = !m_SystemEnabled;
-        Print("[SpawnManager] System toggled: " + m_SystemEnabled.ToString());
+        SpawnLog().Info("System toggled: %1", m_SystemEnabled);
     }
     
     bool IsEnabled()
@@ -887,12 +4280,30 @@ class SimpleSpawnManager : Managed
         Print("[SpawnManager] Enabled: " + m_SystemEnabled.ToString());
         Print("[SpawnManager] Tiers: " + m_Tiers.Count().ToString());
         Print("[SpawnManager] Zones: " + m_ZonesMap.Count().ToString());
-        Print("[SpawnManager] Grid cells: " + m_ZoneGrid.Count().ToString());
+        Print("[SpawnManager] Index cells: " + m_ZoneIndex.GetCellCount().ToString());
+        Print("[SpawnManager] Check interval: " + m_CheckInterval.ToString() + "s (last check " + m_LastCheckMs.ToString() + "ms)");
+        Print("[SpawnManager] Tracked players: " + m_PlayerStates.Count().ToString());
+        Print("[SpawnManager] Zones in reach of players: " + m_ActiveZones.Count().ToString());
+        Print("[SpawnManager] Queued spawns: " + m_SpawnQueue.Count().ToString());
+        Print("[SpawnManager] Queued despawns: " + m_DespawnQueue.Count().ToString());
+        Print("[SpawnManager] Pending lifetime expiries: " + m_LifetimeWheel.GetPendingCount().ToString());
+        
+        string globalBudget = "unlimited";
+        if (m_GlobalSettings.maxTotalEntities > 0)
+            globalBudget = m_GlobalSettings.maxTotalEntities.ToString();
+        
+        Print("[SpawnManager] Tracked entities: " + m_TrackedEntities.Count().ToString() + "/" + globalBudget + " (" + m_ReclaimedEntities.ToString() + " reclaimed)");
+        
+        if (m_EntityPool.IsEnabled())
+        {
+            Print("[SpawnManager] Entity pool: " + m_EntityPool.m_ParkedCount.ToString() + "/" + m_EntityPool.m_Capacity.ToString() + " parked, " + m_EntityPool.m_Hits.ToString() + " hits, " + m_EntityPool.m_Misses.ToString() + " misses");
+        }
         
         int totalSpawnPoints = 0;
         int totalPossibleEntities = 0;
         int totalActiveEntities = 0;
         int zonesWithPlayers = 0;
+        int totalVirtualEntities = 0;
         
         for (int i = 0; i < m_ZonesMap.Count(); i++)
         {
@@ -928,11 +4339,22 @@ class SimpleSpawnManager : Managed
                     Print("[SpawnManager] Zone: " + zone.name);
                 }
                 
+                if (GetZoneBudget() > 0 && zonePossibleEntities > GetZoneBudget())
+                {
+                    zonePossibleEntities = GetZoneBudget();
+                }
+                
                 Print("[SpawnManager]   Entities: " + zoneEntityCount.ToString() + "/" + zonePossibleEntities.ToString());
                 
-                if (zone.cooldownTime > 0)
+                if (zone.virtualCount > 0)
+                {
+                    totalVirtualEntities += zone.virtualCount;
+                    Print("[SpawnManager]   Virtual: " + zone.virtualCount.ToString());
+                }
+                
+                if (IsCoolingDown(zone))
                 {
-                    Print("[SpawnManager]   Cooldown: " + zone.cooldownTime.ToString() + "s");
+                    Print("[SpawnManager]   Cooldown: " + GetCooldownRemaining(zone).ToString() + "s");
                 }
             }
         }
@@ -940,6 +4362,7 @@ class SimpleSpawnManager : Managed
         Print("[SpawnManager] === TOTALS ===");
         Print("[SpawnManager] Active zones: " + zonesWithPlayers.ToString() + "/" + m_ZonesMap.Count().ToString());
         Print("[SpawnManager] Total entities: " + totalActiveEntities.ToString() + "/" + totalPossibleEntities.ToString());
+        Print("[SpawnManager] Virtual entities: " + totalVirtualEntities.ToString());
     }
 }
 
@@ -972,6 +4395,12 @@ void ShutdownMutantSpawnSystem()
     if (g_SpawnManager)
     {
         Print("[MutantWorld] Shutting down spawn system...");
+        
+        // Nothing to save if the configs never finished loading
+        if (g_SpawnManager.m_StateRestored)
+            g_SpawnManager.SaveStateSnapshot();
+        
+        SpawnLog().Flush();
         g_SpawnManager = null;
     }
 }
@@ -1017,46 +4446,53 @@ void ForceSpawnInNearestZone()
     float nearestDistance = 999999.0;
     ref SimpleZone nearestZone = null;
     
-    for (int i = 0; i < g_SpawnManager.m_ZonesMap.Count(); i++)
+    float nearestDistanceSq = nearestDistance * nearestDistance;
+    int nearestId = -1;
+    
+    for (int i = 0; i < g_SpawnManager.m_ZoneList.Count(); i++)
     {
-        string zoneName = g_SpawnManager.m_ZonesMap.GetKey(i);
-        ref SimpleZone zone = g_SpawnManager.m_ZonesMap.GetElement(i);
+        if (!g_SpawnManager.m_ZoneEnabled.Get(i))
+            continue;
         
-        if (zone && zone.enabled)
+        float dx = playerPos[0] - g_SpawnManager.m_ZoneX.Get(i);
+        float dy = playerPos[1] - g_SpawnManager.m_ZoneY.Get(i);
+        float dz = playerPos[2] - g_SpawnManager.m_ZoneZ.Get(i);
+        float distanceSq = dx * dx + dy * dy + dz * dz;
+        if (distanceSq < nearestDistanceSq)
         {
-            float distance = vector.Distance(playerPos, zone.position);
-            if (distance < nearestDistance)
-            {
-                nearestDistance = distance;
-                nearestZoneName = zoneName;
-                nearestZone = zone;
-            }
+            nearestDistanceSq = distanceSq;
+            nearestId = i;
         }
     }
     
+    if (nearestId >= 0)
+    {
+        nearestZone = g_SpawnManager.m_ZoneList.Get(nearestId);
+        nearestZoneName = nearestZone.name;
+        nearestDistance = Math.Sqrt(nearestDistanceSq);
+    }
+    
     if (nearestZone)
     {
         Print("[DEBUG] Nearest zone: " + nearestZoneName + " at " + nearestDistance.ToString() + "m");
         
+        // Clear existing entities now rather than over the next ticks, the spawn below waits for them
+        g_SpawnManager.DespawnFromZone(nearestZone);
+        g_SpawnManager.FlushZoneDespawns(nearestZone);
+        
         // Reset zone state
-        nearestZone.cooldownTime = 0;
+        g_SpawnManager.ClearCooldown(nearestZone);
         nearestZone.hasSpawned = false;
         nearestZone.hasRolledChance = false;
         nearestZone.spawnChance = 1.0;  // Force 100% chance
         
-        // Clear existing entities
-        for (int j = 0; j < nearestZone.spawnPoints.Count(); j++)
-        {
-            ref SimpleSpawnPoint point = nearestZone.spawnPoints.Get(j);
-            if (point)
-            {
-                point.spawnedEntities.Clear();
-            }
-        }
-        
         // Force spawn
-        array<Man> forcePlayers = new array<Man>;
-        forcePlayers.Insert(player);
+        SimplePlayerState forceState = new SimplePlayerState();
+        forceState.playerId = player.GetID();
+        forceState.position = playerPos;
+        
+        array<SimplePlayerState> forcePlayers = new array<SimplePlayerState>;
+        forcePlayers.Insert(forceState);
         g_SpawnManager.TrySpawnInZone(nearestZone, forcePlayers);
     }
     else
@@ -1085,13 +4521,18 @@ void ClearAllSpawnedEntities()
         if (zone)
         {
             g_SpawnManager.DespawnFromZone(zone);
-            zone.cooldownTime = 0;
+            g_SpawnManager.ClearCooldown(zone);
             zone.hasSpawned = false;
             zone.hasRolledChance = false;
         }
     }
     
-    Print("[DEBUG] Cleared all entities");
+    Print("[DEBUG] Cleared all zones, " + g_SpawnManager.m_DespawnQueue.Count().ToString() + " entities queued for deletion");
+}
+
+void DumpSpawnLog()
+{
+    SpawnLog().DumpRecent(SimpleLogger.RING_SIZE);
 }
 
 // Quick Commands
@@ -1100,6 +4541,8 @@ void QuickReload() { if (g_SpawnManager) g_SpawnManager.ForceReload(); }
 void QuickToggle() { if (g_SpawnManager) g_SpawnManager.ToggleSystem(); }
 void QuickSpawn() { ForceSpawnInNearestZone(); }
 void QuickClear() { ClearAllSpawnedEntities(); }
+void QuickBenchmark() { RunSpawnBenchmarks(); }
+void QuickLog() { DumpSpawnLog(); }
 
 // ============= PART 5: AUTO-INIT =============
 
@@ -1113,13 +4556,25 @@ void MutantSpawnSystem_DelayedInit()
 {
     Print("[MutantSpawn] === DELAYED INIT STARTING ===");
     InitMutantSpawnSystem();
-    GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(MutantSpawnSystem_UpdateLoop, 1000, true);
+    GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(MutantSpawnSystem_UpdateLoop, SimpleSpawnManager.UPDATE_INTERVAL_MS, true);
     Print("[MutantSpawn] === OPTIMIZED SPAWN SYSTEM ACTIVE ===");
 }
 
+static float g_MutantSpawnLastUpdateTime = -1.0;
+
 void MutantSpawnSystem_UpdateLoop()
 {
-    UpdateMutantSpawnSystem(1.0);
+    // Pass the real elapsed time so hitches don't make cooldowns and checks drift
+    float now = GetGame().GetTickTime();
+    float timeslice = SimpleSpawnManager.UPDATE_INTERVAL_MS / 1000.0;
+    
+    if (g_MutantSpawnLastUpdateTime >= 0)
+    {
+        timeslice = now - g_MutantSpawnLastUpdateTime;
+    }
+    g_MutantSpawnLastUpdateTime = now;
+    
+    UpdateMutantSpawnSystem(timeslice);
 }
 
 // Automatic start when loading
@@ -1133,4 +4588,351 @@ class MutantSpawnSystemAutoStart
 }
 
 // Create global instance for auto-start
-static ref MutantSpawnSystemAutoStart g_MutantSpawnSystemAutoStart = new MutantSpawnSystemAutoStart();
\ No newline at end of file
+static ref MutantSpawnSystemAutoStart g_MutantSpawnSystemAutoStart = new MutantSpawnSystemAutoStart();
+
+// ============= PART 6: ENTITY EVENT HOOKS =============
+
+// Report spawned creatures dying or being deleted so zone counters update immediately
+modded class ZombieBase
+{
+    override void EEKilled(Object killer)
+    {
+        super.EEKilled(killer);
+        
+        if (g_SpawnManager)
+            g_SpawnManager.OnTrackedEntityGone(this);
+    }
+    
+    override void EEDelete(EntityAI parent)
+    {
+        if (g_SpawnManager)
+            g_SpawnManager.OnTrackedEntityGone(this);
+        
+        super.EEDelete(parent);
+    }
+}
+
+modded class AnimalBase
+{
+    override void EEKilled(Object killer)
+    {
+        super.EEKilled(killer);
+        
+        if (g_SpawnManager)
+            g_SpawnManager.OnTrackedEntityGone(this);
+    }
+    
+    override void EEDelete(EntityAI parent)
+    {
+        if (g_SpawnManager)
+            g_SpawnManager.OnTrackedEntityGone(this);
+        
+        super.EEDelete(parent);
+    }
+}
+// ============= PART 7: SIMULATION HARNESS =============
+
+// A synthetic player walking between random targets on the fake map
+class SimpleFakePlayer : Managed
+{
+    int id;
+    vector position;
+    vector target;
+    float speed;
+    bool online;
+}
+
+// Flat synthetic world with scripted players. Creatures are local proxy objects without AI or
+// network replication, and scheduled calls only run when the harness ticks its call queue.
+class SimpleFakeSpawnWorld : SimpleSpawnWorld
+{
+    static const string PROXY_CLASS = "Apple";
+    
+    float m_MapSize;
+    ref array<ref SimpleFakePlayer> m_Players;
+    ref ScriptCallQueue m_CallQueue;
+    ref RandomGenerator m_Random;  // Own generator, the shared script RNG keeps serving the live server
+    int m_Created;
+    int m_Deleted;
+    
+    void SimpleFakeSpawnWorld(float mapSize, int seed)
+    {
+        m_MapSize = mapSize;
+        m_Players = new array<ref SimpleFakePlayer>;
+        m_CallQueue = new ScriptCallQueue();
+        m_Random = new RandomGenerator();
+        m_Random.SetSeed(seed);
+        m_Created = 0;
+        m_Deleted = 0;
+    }
+    
+    override int GetPlayerSamples(array<ref SimplePlayerSample> samples)
+    {
+        int count = 0;
+        for (int i = 0; i < m_Players.Count(); i++)
+        {
+            SimpleFakePlayer player = m_Players.Get(i);
+            if (!player.online)
+                continue;
+            
+            SimplePlayerSample sample = GetSampleSlot(samples, count);
+            sample.id = player.id;
+            sample.position = player.position;
+            count++;
+        }
+        return count;
+    }
+    
+    override EntityAI CreateEntity(string type, vector position)
+    {
+        EntityAI entity = EntityAI.Cast(GetGame().CreateObjectEx(PROXY_CLASS, position, ECE_LOCAL));
+        if (entity)
+            m_Created++;
+        
+        return entity;
+    }
+    
+    override void DeleteEntity(EntityAI entity)
+    {
+        m_Deleted++;
+        GetGame().ObjectDelete(entity);
+    }
+    
+    override float SurfaceY(float x, float z)
+    {
+        return 0;
+    }
+    
+    override bool ValidateSpawnPosition(vector position, out vector resolved)
+    {
+        resolved = position;
+        return true;
+    }
+    
+    override ScriptCallQueue GetCallQueue()
+    {
+        return m_CallQueue;
+    }
+    
+    vector RandomPosition()
+    {
+        return Vector(RandomFloat(0, m_MapSize), 0, RandomFloat(0, m_MapSize));
+    }
+    
+    float RandomFloat(float min, float max)
+    {
+        return m_Random.RandFloat(min, max);
+    }
+    
+    int RandomIntInclusive(int min, int max)
+    {
+        return m_Random.RandInt(min, max + 1);
+    }
+    
+    SimpleFakePlayer AddPlayer(vector position, float speed)
+    {
+        SimpleFakePlayer player = new SimpleFakePlayer();
+        player.id = m_Players.Count() + 1;
+        player.position = position;
+        player.target = position;
+        player.speed = speed;
+        player.online = true;
+        m_Players.Insert(player);
+        return player;
+    }
+    
+    // Moves every online player toward its target, picking a new random target on arrival
+    // unless the scenario pinned one
+    void MovePlayers(float timeslice, bool wander)
+    {
+        for (int i = 0; i < m_Players.Count(); i++)
+        {
+            SimpleFakePlayer player = m_Players.Get(i);
+            if (!player.online)
+                continue;
+            
+            vector delta = player.target - player.position;
+            float distance = delta.Length();
+            float step = player.speed * timeslice;
+            
+            if (distance <= step)
+            {
+                player.position = player.target;
+                if (wander)
+                    player.target = RandomPosition();
+            }
+            else
+            {
+                player.position = player.position + delta * (step / distance);
+            }
+        }
+    }
+    
+    void Tick(float timeslice, bool wander)
+    {
+        MovePlayers(timeslice, wander);
+        m_CallQueue.Tick(timeslice);
+    }
+}
+
+// Runs the manager against a fake world for a fixed number of simulated seconds and reports
+// manager ticks per real second and spawn/despawn counts. Everything runs synchronously in one
+// server frame, so only use it on a test server.
+class SimpleSpawnBenchmark : Managed
+{
+    static const float TICK_SECONDS = 1.0;
+    
+    ref SimpleFakeSpawnWorld m_World;
+    ref SimpleSpawnManager m_Manager;
+    
+    void Setup(int zoneCount, int playerCount, float mapSize, int seed)
+    {
+        m_World = new SimpleFakeSpawnWorld(mapSize, seed);
+        m_Manager = new SimpleSpawnManager(m_World);
+        
+        GlobalSettingsConfig settings = new GlobalSettingsConfig();
+        settings.checkInterval = 2.0;
+        settings.entityLifetime = 0;
+        m_Manager.ApplyGlobalSettings(settings);
+        
+        SimpleTier tier = new SimpleTier();
+        tier.name = "Benchmark";
+        tier.classnames.Insert("ZmbM_CitizenASkinny");
+        m_Manager.m_Tiers.Set(1, tier);
+        
+        map<string, ref SimpleZone> zones = new map<string, ref SimpleZone>;
+        for (int i = 0; i < zoneCount; i++)
+        {
+            SimpleZone zone = new SimpleZone();
+            zone.name = "Bench_" + i.ToString();
+            zone.position = m_World.RandomPosition();
+            zone.triggerRadius = m_World.RandomFloat(50, 200);
+            zone.despawnDistance = zone.triggerRadius + 100;
+            zone.respawnCooldown = 120;
+            
+            int pointCount = m_World.RandomIntInclusive(1, 3);
+            for (int j = 0; j < pointCount; j++)
+            {
+                SimpleSpawnPoint point = new SimpleSpawnPoint();
+                point.position = zone.position + Vector(m_World.RandomFloat(-40, 40), 0, m_World.RandomFloat(-40, 40));
+                point.radius = 10;
+                point.entities = m_World.RandomIntInclusive(1, 4);
+                point.tierIds.Insert(1);
+                zone.spawnPoints.Insert(point);
+            }
+            
+            zones.Set(zone.name, zone);
+        }
+        
+        m_Manager.ApplyZoneDiff(zones);
+        m_Manager.BuildSpatialGrid();
+        m_Manager.BuildSpawnTables();
+        
+        for (int p = 0; p < playerCount; p++)
+        {
+            m_World.AddPlayer(m_World.RandomPosition(), m_World.RandomFloat(2, 7));
+        }
+    }
+    
+    // Simulates the given number of seconds and prints one result line
+    void Run(string scenario, float seconds, bool wander)
+    {
+        int createdBefore = m_World.m_Created;
+        int deletedBefore = m_World.m_Deleted;
+        int ticks = 0;
+        float maxTickMs = 0;
+        int startTicks = TickCount(0);
+        
+        for (float t = 0; t < seconds; t += TICK_SECONDS)
+        {
+            int tickStart = TickCount(0);
+            m_World.Tick(TICK_SECONDS, wander);
+            m_Manager.Update(TICK_SECONDS);
+            maxTickMs = Math.Max(maxTickMs, TickCount(tickStart) / 10000.0);
+            ticks++;
+        }
+        
+        float elapsedMs = TickCount(startTicks) / 10000.0;
+        float ticksPerSecond = 0;
+        if (elapsedMs > 0)
+            ticksPerSecond = ticks * 1000.0 / elapsedMs;
+        
+        int spawned = m_World.m_Created - createdBefore;
+        int despawned = m_World.m_Deleted - deletedBefore;
+        
+        Print("[Benchmark] " + scenario + ": " + ticks.ToString() + " ticks in " + elapsedMs.ToString() + "ms, " + ticksPerSecond.ToString() + " ticks/s, max tick " + maxTickMs.ToString() + "ms, " + spawned.ToString() + " spawned, " + despawned.ToString() + " despawned, " + m_Manager.m_TrackedEntities.Count().ToString() + " alive");
+    }
+    
+    // Deletes everything the scenario created
+    void Teardown()
+    {
+        for (int i = 0; i < m_Manager.m_ZoneList.Count(); i++)
+        {
+            m_Manager.DespawnFromZone(m_Manager.m_ZoneList.Get(i));
+        }
+        
+        m_Manager.FlushDespawnQueue();
+        m_Manager.StopSpawnPump();
+        m_Manager = null;
+        m_World = null;
+    }
+}
+
+// Players wandering randomly across a large map
+void SpawnBenchmark_Roaming(int playerCount, int zoneCount)
+{
+    SimpleSpawnBenchmark bench = new SimpleSpawnBenchmark();
+    bench.Setup(zoneCount, playerCount, 15000, 1);
+    bench.Run("Roaming " + playerCount.ToString() + " players x " + zoneCount.ToString() + " zones", 600, true);
+    bench.Teardown();
+}
+
+// A squad of players walking into the same zone together
+void SpawnBenchmark_SquadEntry(int squadSize, int zoneCount)
+{
+    SimpleSpawnBenchmark bench = new SimpleSpawnBenchmark();
+    bench.Setup(zoneCount, 0, 15000, 2);
+    
+    SimpleZone zone = bench.m_Manager.m_ZoneList.Get(0);
+    for (int i = 0; i < squadSize; i++)
+    {
+        vector start = zone.position + Vector(zone.despawnDistance + 50 + i * 2, 0, 0);
+        SimpleFakePlayer player = bench.m_World.AddPlayer(start, 5);
+        player.target = zone.position;
+    }
+    
+    bench.Run("Squad entry " + squadSize.ToString() + " players", 120, false);
+    bench.Teardown();
+}
+
+// Everybody inside zones logs out at once
+void SpawnBenchmark_MassLogout(int playerCount, int zoneCount)
+{
+    SimpleSpawnBenchmark bench = new SimpleSpawnBenchmark();
+    bench.Setup(zoneCount, 0, 15000, 3);
+    
+    for (int i = 0; i < playerCount; i++)
+    {
+        SimpleZone zone = bench.m_Manager.m_ZoneList.Get(i % zoneCount);
+        bench.m_World.AddPlayer(zone.position, 0);
+    }
+    
+    bench.Run("Mass logout warmup", 60, false);
+    
+    for (int p = 0; p < bench.m_World.m_Players.Count(); p++)
+    {
+        bench.m_World.m_Players.Get(p).online = false;
+    }
+    
+    bench.Run("Mass logout " + playerCount.ToString() + " players", 60, false);
+    bench.Teardown();
+}
+
+void RunSpawnBenchmarks()
+{
+    Print("[Benchmark] === SPAWN MANAGER BENCHMARKS ===");
+    SpawnBenchmark_Roaming(100, 2000);
+    SpawnBenchmark_SquadEntry(8, 2000);
+    SpawnBenchmark_MassLogout(100, 2000);
+    Print("[Benchmark] === DONE ===");
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+// ============= MutantSpawnSystemMission.c =============
+// Mission hooks for the spawn system defined in 4_World
+
+modded class MissionServer
+{
+    // Saves zone cooldowns and flushes the log before the world goes away
+    override void OnMissionFinish()
+    {
+        ShutdownMutantSpawnSystem();
+        super.OnMissionFinish();
+    }
+}
\ No newline at end of file